@@ -2,6 +2,8 @@
 GLOBAL _cli
 GLOBAL _sti
 GLOBAL _hlt
+GLOBAL _cliSave
+GLOBAL _restoreFlags
 
 GLOBAL picMasterMask
 GLOBAL picSlaveMask
@@ -161,6 +163,19 @@ _sti:
 	sti
 	ret
 
+; uint64_t _cliSave(void)
+_cliSave:
+	pushfq
+	pop rax
+	cli
+	ret
+
+; void _restoreFlags(uint64_t flags)
+_restoreFlags:
+	push rdi
+	popfq
+	ret
+
 picMasterMask:
 	push rbp     ; Stack frame
 	mov rbp, rsp
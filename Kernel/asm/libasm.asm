@@ -1,6 +1,5 @@
 GLOBAL cpuVendor
 GLOBAL getKeyboardBuffer
-GLOBAL _xchg
 GLOBAL _xadd
 
 GLOBAL getSecond
@@ -13,6 +12,14 @@ GLOBAL setSpeaker
 
 GLOBAL getRegisterSnapshot
 GLOBAL forceTimerTick
+
+GLOBAL _cpuidEdx
+GLOBAL _rdmsr
+GLOBAL _wrmsr
+GLOBAL _rdtsc
+GLOBAL _readCR3
+GLOBAL _invlpg
+GLOBAL _wbinvd
 EXTERN register_snapshot
 EXTERN register_snapshot_taken
 
@@ -123,17 +130,6 @@ setSpeaker:
 	pop rbp
 	ret
 
-; Atomic exchange: returns previous *addr, stores newValue at *addr
-; uint64_t _xchg(volatile uint64_t *addr, uint64_t newValue)
-_xchg:
-    push rbp
-    mov rbp, rsp
-    mov rax, rsi        ; rax = newValue
-    lock xchg [rdi], rax ; swap *addr with rax atomically
-    mov rsp, rbp
-    pop rbp
-    ret
-
 ; void* _initialize_stack_frame(void (*entry)(void*, void*), void *func, void *stack_end, void *arg1, void *arg2)
 ; For now, just return an aligned stack pointer. The scheduler/ISR glue is not switching yet.
 _xadd:
@@ -149,3 +145,52 @@ _xadd:
 forceTimerTick:
     int 0x20
     ret
+
+; uint32_t _cpuidEdx(uint32_t leaf)
+_cpuidEdx:
+    push rbx                ; cpuid pisa rbx, que es callee-saved
+    mov eax, edi
+    xor ecx, ecx
+    cpuid
+    mov eax, edx
+    pop rbx
+    ret
+
+; uint64_t _rdmsr(uint32_t msr)
+_rdmsr:
+    mov ecx, edi
+    rdmsr
+    shl rdx, 32
+    or rax, rdx
+    ret
+
+; void _wrmsr(uint32_t msr, uint64_t value)
+_wrmsr:
+    mov ecx, edi
+    mov rax, rsi
+    mov rdx, rsi
+    shr rdx, 32
+    wrmsr
+    ret
+
+; uint64_t _rdtsc(void)
+_rdtsc:
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    ret
+
+; uint64_t _readCR3(void)
+_readCR3:
+    mov rax, cr3
+    ret
+
+; void _invlpg(uint64_t address)
+_invlpg:
+    invlpg [rdi]
+    ret
+
+; void _wbinvd(void)
+_wbinvd:
+    wbinvd
+    ret
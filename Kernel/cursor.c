@@ -18,6 +18,15 @@ int toggleSpeed(void) {
     return ticks_elapsed() / TOGGLE_TICKS;
 }
 
+// Whether toggleCursor would draw or hide the cursor right now
+uint8_t cursorNeedsToggle(void) {
+    int toggle = toggleSpeed() % 2;
+    if (keyboard_options == 0 || keyboard_options == MODIFY_BUFFER) {
+        return IS_SHOWING;
+    }
+    return (toggle == 1) != IS_SHOWING;
+}
+
 void toggleCursor(void) {
     int toggle = toggleSpeed() % 2;
     if (keyboard_options == 0 || keyboard_options == MODIFY_BUFFER){
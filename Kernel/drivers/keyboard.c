@@ -7,11 +7,14 @@
 #include <cursor.h>
 #include <stddef.h>
 #include <scheduler.h>
-#include <semaphore_manager.h>
+#include <time.h>
+#include <wait_queue.h>
+#include <deferred_work.h>
 
 #define BUFFER_SIZE 1024
 
-#define BUFFER_IS_FULL ((to_write - to_read) % BUFFER_SIZE == BUFFER_SIZE - 1)
+#define BUFFER_IS_FULL(q) (((q)->to_write - (q)->to_read + BUFFER_SIZE) % BUFFER_SIZE == BUFFER_SIZE - 1)
+#define LAST_CHAR(q) ((q)->buffer[SUB_MOD((q)->to_write, 1, BUFFER_SIZE)])
 
 #define IS_ALPHA(c) ('a' <= (c) && (c) <= 'z') 
 #define TO_UPPER(c) (IS_ALPHA(c) ? ((c) - 'a' + 'A') : (c))
@@ -36,19 +39,65 @@
 #define SUB_MOD(a, b, m) ((a) - (b) < 0 ? (m) - (b) + (a) : (a) - (b))
 #define DEC_MOD(x, m) ((x) = SUB_MOD(x, 1, m))
 
+// A key press as captured by the interrupt handler, packed into a deferred work argument
+#define KEY_WORK(keycode, c, printable, control) \
+    ((uint64_t) (keycode) | ((uint64_t) (uint8_t) (c) << 8) | ((uint64_t) (printable) << 16) | ((uint64_t) (control) << 17))
+#define KEY_WORK_KEYCODE(arg) ((uint8_t) (arg))
+#define KEY_WORK_CHAR(arg) ((int8_t) ((arg) >> 8))
+#define KEY_WORK_PRINTABLE(arg) (((arg) >> 16) & 1)
+#define KEY_WORK_CONTROL(arg) (((arg) >> 17) & 1)
+
 static uint8_t SHIFT_KEY_PRESSED, CAPS_LOCK_KEY_PRESSED, CONTROL_KEY_PRESSED;
-static int8_t buffer[BUFFER_SIZE];
-static uint16_t to_write = 0, to_read = 0;
-uint8_t keyboard_options = 0;
+uint8_t keyboard_options = 0; // options of the focused consumer's pending read, 0 if it is not reading
+
+// Input router: every process reading the console owns an input queue. The queues form a
+// focus stack; keystrokes only go to the queue on top, and only its readers are woken.
+// A foreground process takes the focus from the parent that created it and hands it back
+// when it exits, so background or outer readers never race the focused one.
+typedef struct {
+    uint8_t in_use;
+    int32_t owner; // pid
+    int8_t buffer[BUFFER_SIZE];
+    uint16_t to_write, to_read;
+    uint8_t options; // options of the owner's pending read, 0 if it is not reading
+    WaitQueueADT readers;
+} InputQueue;
+
+static InputQueue input_queues[INPUT_CONSUMERS];
+static InputQueue *focus_stack[INPUT_CONSUMERS]; // focus_stack[focus_depth - 1] has the focus
+static uint8_t focus_depth = 0;
+static enum CONSOLE_MODES console_mode = CONSOLE_CANONICAL;
+static int32_t console_mode_owner = -1;
+
+typedef struct {
+    int32_t owner; // pid, -1 if the slot is free
+    uint16_t head, tail;
+    KeyEvent events[KEY_EVENT_RING_SIZE];
+} KeyEventRing;
+
+static KeyEventRing key_event_rings[KEY_EVENT_CONSUMERS];
+static uint8_t key_event_rings_ready = 0;
 
 typedef struct {
     uint8_t registered_from_kernel;
+    int32_t owner; // pid that registered fn, unused for kernel handlers
     SpecialKeyHandler fn;
 } RegisteredKeys;
 
 #define KEY_FN_MAP_LEN (F12_KEY - ESCAPE_KEY + 1)
 static RegisteredKeys KeyFnMap[ KEY_FN_MAP_LEN ] = {0};
 
+// Handlers registered by a process run in that process, with its descriptors and local
+// storage, the next time it waits for console input. Until then the key waits here
+#define PENDING_KEY_HANDLERS 32
+typedef struct {
+    int32_t owner;
+    uint8_t keycode;
+} PendingKeyHandler;
+
+static PendingKeyHandler pending_key_handlers[PENDING_KEY_HANDLERS];
+static uint8_t pending_key_count = 0;
+
 // QEMU source https://github.com/qemu/qemu/blob/master/pc-bios/keymaps/en-us
 // http://flint.cs.yale.edu/feng/cos/resources/BIOS/Resources/assembly/makecodes.html
 // Array of scancodes to ASCII - Shift-Modified-ASCII
@@ -178,6 +227,7 @@ uint8_t registerSpecialKey(enum KEYS scancode, SpecialKeyHandler fn, uint8_t reg
     if (entry != NULL && (registeredFromKernel != 0 || entry->fn == NULL)) {
         entry->fn = fn;
         entry->registered_from_kernel = registeredFromKernel;
+        entry->owner = registeredFromKernel ? -1 : getpid();
         return 1;
     }
 
@@ -209,124 +259,448 @@ static uint8_t makeCode(uint8_t scancode) {
     return scancode & 0x7F;
 }
 
-void addCharToBuffer(int8_t ascii, uint8_t showOutput) {
+static InputQueue *focusedQueue(void) {
+    return focus_depth > 0 ? focus_stack[focus_depth - 1] : NULL;
+}
+
+static void refreshKeyboardOptions(void) {
+    InputQueue *queue = focusedQueue();
+    keyboard_options = queue != NULL ? queue->options : 0;
+}
+
+static InputQueue *findQueue(int32_t owner) {
+    for (uint8_t i = 0; i < focus_depth; i++) {
+        if (focus_stack[i]->owner == owner) {
+            return focus_stack[i];
+        }
+    }
+    return NULL;
+}
+
+// Takes a free queue and places it at `depth` in the focus stack
+static InputQueue *insertQueue(int32_t owner, uint8_t depth) {
+    if (focus_depth == INPUT_CONSUMERS) {
+        return NULL;
+    }
+    InputQueue *queue = NULL;
+    for (int i = 0; i < INPUT_CONSUMERS && queue == NULL; i++) {
+        if (!input_queues[i].in_use) {
+            queue = &input_queues[i];
+        }
+    }
+    if (queue == NULL || (queue->readers == NULL && (queue->readers = createWaitQueue()) == NULL)) {
+        return NULL;
+    }
+    queue->in_use = 1;
+    queue->owner = owner;
+    queue->to_write = queue->to_read = 0;
+    queue->options = 0;
+
+    for (uint8_t i = focus_depth; i > depth; i--) {
+        focus_stack[i] = focus_stack[i - 1];
+    }
+    focus_stack[depth] = queue;
+    focus_depth++;
+    refreshKeyboardOptions();
+    return queue;
+}
+
+int8_t inputFocusPush(int32_t owner) {
+    if (findQueue(owner) != NULL) {
+        return 0;
+    }
+    return insertQueue(owner, focus_depth) != NULL ? 0 : -1;
+}
+
+static void dropPendingKeyHandler(uint8_t index) {
+    for (uint8_t i = index; i + 1 < pending_key_count; i++) {
+        pending_key_handlers[i] = pending_key_handlers[i + 1];
+    }
+    pending_key_count--;
+}
+
+// Wakes the owner if it is waiting for input, so the handler runs right away
+static void queueKeyHandler(int32_t owner, uint8_t keycode) {
+    if (pending_key_count == PENDING_KEY_HANDLERS) {
+        return; // dropped, like a key that does not fit in the input buffer
+    }
+    pending_key_handlers[pending_key_count].owner = owner;
+    pending_key_handlers[pending_key_count].keycode = keycode;
+    pending_key_count++;
+    InputQueue *queue = findQueue(owner);
+    if (queue != NULL) {
+        waitQueueWakeAll(queue->readers);
+    }
+}
+
+// Runs, in the calling process, the handlers queued for it. The entry leaves the queue
+// before its handler runs, and a handler registered by someone else since then is skipped
+static void runKeyHandlers(void) {
+    int32_t pid = getpid();
+    uint8_t i = 0;
+    while (i < pending_key_count) {
+        if (pending_key_handlers[i].owner != pid) {
+            i++;
+            continue;
+        }
+        uint8_t keycode = pending_key_handlers[i].keycode;
+        dropPendingKeyHandler(i);
+        RegisteredKeys *entry = getKeyFnEntry(keycode);
+        if (entry != NULL && entry->fn != NULL && !entry->registered_from_kernel && entry->owner == pid) {
+            entry->fn(keycode);
+        }
+    }
+}
+
+void inputFocusRemove(int32_t owner) {
+    for (uint8_t i = 0; i < pending_key_count;) {
+        if (pending_key_handlers[i].owner == owner) {
+            dropPendingKeyHandler(i);
+        } else {
+            i++;
+        }
+    }
+    for (uint8_t i = 0; i < focus_depth; i++) {
+        if (focus_stack[i]->owner != owner) {
+            continue;
+        }
+        InputQueue *queue = focus_stack[i];
+        for (uint8_t j = i; j + 1 < focus_depth; j++) {
+            focus_stack[j] = focus_stack[j + 1];
+        }
+        focus_depth--;
+        queue->in_use = 0;
+        waitQueueWakeAll(queue->readers); // a reader other than the owner (READ_FOCUSED) retries on the new focus
+        refreshKeyboardOptions();
+        return;
+    }
+}
+
+int32_t getFocusedPid(void) {
+    InputQueue *queue = focusedQueue();
+    return queue != NULL ? queue->owner : -1;
+}
+
+// Processes in the focused process' job share its queue.
+// Any other reader without a queue lines up right below the focused consumer and is
+// served once everything above it exits.
+static InputQueue *readerQueue(enum KEYBOARD_OPTIONS ops) {
+    InputQueue *focused = focusedQueue();
+    if (ops & READ_FOCUSED) {
+        return focused;
+    }
+    int32_t pid = getpid();
+    InputQueue *queue = findQueue(pid);
+    if (queue == NULL && focused != NULL && processesShareJob(pid, focused->owner)) {
+        queue = focused;
+    }
+    if (queue == NULL) {
+        queue = insertQueue(pid, focus_depth > 0 ? focus_depth - 1 : 0);
+    }
+    return queue;
+}
+
+static void pushChar(InputQueue *queue, int8_t ascii, uint8_t showOutput) {
     if (ascii != TABULATOR_CHAR) {
-        buffer[to_write] = ascii;
-        INC_MOD(to_write, BUFFER_SIZE);
+        if (BUFFER_IS_FULL(queue)) {
+            return; // keys are dropped until the reader catches up
+        }
+        queue->buffer[queue->to_write] = ascii;
+        INC_MOD(queue->to_write, BUFFER_SIZE);
         if (showOutput)
             putChar(ascii);
         return ;
     }
 
     do {
-        addCharToBuffer(' ', showOutput);
-    } while( !BUFFER_IS_FULL && getXBufferPosition() % (TAB_SIZE * DEFAULT_GLYPH_SIZE_X * getFontSize()) != 0);
+        pushChar(queue, ' ', showOutput);
+    } while( !BUFFER_IS_FULL(queue) && getXBufferPosition() % (TAB_SIZE * DEFAULT_GLYPH_SIZE_X * getFontSize()) != 0);
+}
+
+void addCharToBuffer(int8_t ascii, uint8_t showOutput) {
+    InputQueue *queue = focusedQueue();
+    if (queue != NULL) {
+        pushChar(queue, ascii, showOutput);
+    }
 }
 
 uint16_t clearBuffer() {
-    uint16_t aux = SUB_MOD(to_write, to_read, BUFFER_SIZE);
+    InputQueue *queue = focusedQueue();
+    if (queue == NULL) return 0;
+    uint16_t aux = SUB_MOD(queue->to_write, queue->to_read, BUFFER_SIZE);
     if (aux == 0) return 0;
-    DEC_MOD(to_write, BUFFER_SIZE);
+    DEC_MOD(queue->to_write, BUFFER_SIZE);
     clearPreviousCharacter();
     return aux;
 }
 
-// Halts until any key is pressed or \n is entered, depending on keyboard_options (AWAIT_RETURN_KEY)
+static uint8_t readReady(InputQueue *queue) {
+    return queue->to_write != queue->to_read && // always get at least one char from the buffer if empty
+        (   !(queue->options & AWAIT_RETURN_KEY) || // or wait for \n or EOF to be entered by the user
+            LAST_CHAR(queue) == NEW_LINE_CHAR || LAST_CHAR(queue) == EOF
+        );
+}
+
+// Halts until any key is pressed or \n is entered, depending on ops (AWAIT_RETURN_KEY)
 // This function always sets the MODIFY_BUFFER option, so keys can be consumed
-int8_t getKeyboardCharacter(enum KEYBOARD_OPTIONS ops) {
-    keyboard_options = ops | MODIFY_BUFFER;
-
-    while(
-        to_write == to_read || // always get at least one char from the buffer if empty
-        (   (keyboard_options & AWAIT_RETURN_KEY) && // wait for \n or EOF to be entered by the user
-            !(buffer[SUB_MOD(to_write, 1, BUFFER_SIZE)] == NEW_LINE_CHAR || buffer[SUB_MOD(to_write, 1, BUFFER_SIZE)] == EOF)
-        )) {
-            semWait(1);
-        };
-
-    keyboard_options = 0;
-    int8_t aux = buffer[to_read];
-    INC_MOD(to_read, BUFFER_SIZE);
+static int8_t readQueueCharacter(InputQueue *queue, enum KEYBOARD_OPTIONS ops) {
+    queue->options = (ops & ~READ_FOCUSED) | MODIFY_BUFFER;
+    refreshKeyboardOptions();
+
+    runKeyHandlers();
+    while (!readReady(queue)) {
+        waitQueueSleep(queue->readers);
+        runKeyHandlers();
+        if (!queue->in_use) { // the owner of the focused queue went away (READ_FOCUSED)
+            if ((queue = readerQueue(ops)) == NULL)
+                return EOF;
+            queue->options = (ops & ~READ_FOCUSED) | MODIFY_BUFFER;
+            refreshKeyboardOptions();
+        }
+    }
+
+    queue->options = 0;
+    refreshKeyboardOptions();
+    int8_t aux = queue->buffer[queue->to_read];
+    INC_MOD(queue->to_read, BUFFER_SIZE);
     return aux;
 }
 
-uint8_t keyboardHandler(){
-    uint8_t scancode = getKeyboardBuffer();
-    uint8_t is_pressed = isPressed(scancode);
+int8_t getKeyboardCharacter(enum KEYBOARD_OPTIONS ops) {
+    InputQueue *queue = readerQueue(ops);
+    return queue != NULL ? readQueueCharacter(queue, ops) : EOF;
+}
 
-    if(BUFFER_IS_FULL){
-        to_read = to_write = 0;
-        return scancode; // do not write to buffer anymore, subsequent keys are not processed into the buffer
+// Line discipline for the console's stdin. Echo, backspace, ^D and ^C are handled by the
+// deferred key handler while a reader waits; here a canonical read blocks until a whole line
+// (or EOF) is typed and hands all of it back at once. A raw read does not echo nor wait
+// for RETURN: it returns whatever keys are already buffered, at least one.
+int64_t readConsole(char * destination, uint64_t len) {
+    if (len == 0) {
+        return 0;
     }
-    
-    const uint8_t keycode = makeCode(scancode);
 
-    switch (keycode) {
-        case SHIFT_KEY_L:
-        case SHIFT_KEY_R:
-            SHIFT_KEY_PRESSED = is_pressed;
-            break;
-        case CONTROL_KEY_L:
-            CONTROL_KEY_PRESSED = is_pressed;
-            break;
-        case CAPS_LOCK_KEY:
-            if (is_pressed)
-                CAPS_LOCK_KEY_PRESSED = !CAPS_LOCK_KEY_PRESSED;
-            break;
+    uint8_t canonical = console_mode == CONSOLE_CANONICAL;
+    enum KEYBOARD_OPTIONS ops = canonical ? AWAIT_RETURN_KEY | SHOW_BUFFER_WHILE_TYPING : 0;
+    InputQueue *queue = readerQueue(ops);
+    if (queue == NULL) {
+        return -1;
     }
-    
-    if (!(is_pressed && IS_KEYCODE(keycode))) {
-        return scancode; // ignore break or unsupported scancodes
+    int8_t c = readQueueCharacter(queue, ops);
+    destination[0] = c;
+
+    uint64_t i = 1;
+    while (i < len && queue->to_read != queue->to_write && !(canonical && (c == NEW_LINE_CHAR || c == EOF))) {
+        c = queue->buffer[queue->to_read];
+        INC_MOD(queue->to_read, BUFFER_SIZE);
+        destination[i++] = c;
     }
-    
-    // Global Ctrl+C detection (works even when no stdin read is in progress)
-    if (CONTROL_KEY_PRESSED && keycode == 0x2E) { // scancode 0x2E == 'c'/'C'
-        to_read = to_write = 0;         // flush input buffer
-        killForegroundProcess();        // request scheduler to kill fg process
-        print("CTRL+C pressed\n");
-        semPost(1);
-        return scancode;
+    return i;
+}
+
+static KeyEventRing *getKeyEventRing(int32_t owner) {
+    if (!key_event_rings_ready) {
+        for (int i = 0; i < KEY_EVENT_CONSUMERS; i++) {
+            key_event_rings[i].owner = -1;
+        }
+        key_event_rings_ready = 1;
     }
-    
-    if ((keyboard_options & MODIFY_BUFFER) != 0) {
-        int8_t c = scancodeMap[keycode][SHIFT_KEY_PRESSED];
+    for (int i = 0; i < KEY_EVENT_CONSUMERS; i++) {
+        if (key_event_rings[i].owner == owner) {
+            return &key_event_rings[i];
+        }
+    }
+    return NULL;
+}
+
+int8_t keyEventsOpen(int32_t owner) {
+    if (owner < 0) {
+        return -1;
+    }
+    if (getKeyEventRing(owner) != NULL) {
+        return 0;
+    }
+    KeyEventRing *ring = getKeyEventRing(-1);
+    if (ring == NULL) {
+        return -1;
+    }
+    ring->head = ring->tail = 0;
+    ring->owner = owner;
+    return 0;
+}
 
-        if (CAPS_LOCK_KEY_PRESSED == 1) {
+int64_t keyEventsRead(int32_t owner, KeyEvent * events, uint32_t max) {
+    KeyEventRing *ring = owner < 0 ? NULL : getKeyEventRing(owner);
+    if (ring == NULL || events == NULL) {
+        return -1;
+    }
+    uint32_t count = 0;
+    while (count < max && ring->tail != ring->head) {
+        events[count++] = ring->events[ring->tail];
+        INC_MOD(ring->tail, KEY_EVENT_RING_SIZE);
+    }
+    return count;
+}
+
+int8_t keyEventsClose(int32_t owner) {
+    KeyEventRing *ring = owner < 0 ? NULL : getKeyEventRing(owner);
+    if (ring == NULL) {
+        return -1;
+    }
+    ring->owner = -1;
+    return 0;
+}
+
+static uint8_t currentModifiers(void) {
+    return (SHIFT_KEY_PRESSED ? KEY_MOD_SHIFT : 0) |
+           (CONTROL_KEY_PRESSED ? KEY_MOD_CONTROL : 0) |
+           (CAPS_LOCK_KEY_PRESSED ? KEY_MOD_CAPS_LOCK : 0);
+}
+
+// A full ring drops its oldest event: losing a stale press is better than losing a release
+static void publishKeyEvent(uint8_t keycode, uint8_t pressed) {
+    if (!key_event_rings_ready) {
+        return;
+    }
+    KeyEvent event = {
+        .ticks = ticks_elapsed(),
+        .scancode = keycode,
+        .pressed = pressed,
+        .modifiers = currentModifiers(),
+        .ascii = 0,
+    };
+    if (IS_PRINTABLE(keycode)) {
+        int8_t c = scancodeMap[keycode][SHIFT_KEY_PRESSED];
+        if (c == RETURN_KEY) {
+            c = NEW_LINE_CHAR;
+        } else if (c == TABULATOR_KEY) {
+            c = TABULATOR_CHAR;
+        } else if (CAPS_LOCK_KEY_PRESSED) {
             c = TO_UPPER(c);
         }
+        event.ascii = c;
+    }
+    for (int i = 0; i < KEY_EVENT_CONSUMERS; i++) {
+        KeyEventRing *ring = &key_event_rings[i];
+        if (ring->owner == -1) {
+            continue;
+        }
+        ring->events[ring->head] = event;
+        INC_MOD(ring->head, KEY_EVENT_RING_SIZE);
+        if (ring->head == ring->tail) {
+            INC_MOD(ring->tail, KEY_EVENT_RING_SIZE);
+        }
+    }
+}
+
+int8_t setConsoleMode(int32_t owner, enum CONSOLE_MODES mode) {
+    if (mode != CONSOLE_CANONICAL && mode != CONSOLE_RAW) {
+        return -1;
+    }
+    console_mode = mode;
+    console_mode_owner = mode == CONSOLE_RAW ? owner : -1;
+    return 0;
+}
+
+// The console goes back to canonical mode when whoever made it raw exits
+void releaseConsoleMode(int32_t owner) {
+    if (console_mode_owner == owner) {
+        setConsoleMode(owner, CONSOLE_CANONICAL);
+    }
+}
+
+// Bottom half of the keyboard interrupt: line discipline, echo and registered key handlers.
+// It runs in the deferred worker, in the order the keys were pressed.
+static void handleKey(uint64_t arg) {
+    const uint8_t keycode = KEY_WORK_KEYCODE(arg);
+    const uint8_t control = KEY_WORK_CONTROL(arg);
+    int8_t c = KEY_WORK_CHAR(arg);
+    InputQueue *queue = focusedQueue();
+
+    // Global Ctrl+C detection (works even when no stdin read is in progress)
+    if (control && keycode == 0x2E) { // scancode 0x2E == 'c'/'C'
+        if (queue != NULL) {
+            queue->to_read = queue->to_write = 0;   // flush input buffer
+            killForegroundProcess(queue->owner);    // only the focused job is interrupted
+        }
+        print("CTRL+C pressed\n");
+        return;
+    }
 
+    if (queue != NULL && (queue->options & MODIFY_BUFFER) != 0) {
         // Detect Ctrl + D: push EOF sentinel into input buffer (no echo)
-        if (CONTROL_KEY_PRESSED && keycode == 0x20) { // scancode 0x20 == 'd'/'D'
-            buffer[to_write] = EOF;
-            INC_MOD(to_write, BUFFER_SIZE);
-            semPost(1);
-            return scancode;
+        if (control && keycode == 0x20) { // scancode 0x20 == 'd'/'D'
+            pushChar(queue, EOF, 0);
+            waitQueueWakeAll(queue->readers);
+            return;
         }
 
-        if (IS_PRINTABLE(keycode)) {
+        if (KEY_WORK_PRINTABLE(arg)) {
             if(c == RETURN_KEY){
                 c = NEW_LINE_CHAR;
-                // Handle \n on the keyboard interrupt handler, to avoid the possibility of triggering multiple \n inputs continously on the same sys_read
-                if ( (to_write != to_read) && buffer[SUB_MOD(to_write, 1, BUFFER_SIZE)] == NEW_LINE_CHAR ) {
-                    return scancode;
+                // Handle \n here, to avoid the possibility of triggering multiple \n inputs continously on the same sys_read
+                if ( (queue->to_write != queue->to_read) && LAST_CHAR(queue) == NEW_LINE_CHAR ) {
+                    return;
                 }
             } else if(c == TABULATOR_KEY){
                 c = TABULATOR_CHAR;
             }
 
-            addCharToBuffer(c, keyboard_options & SHOW_BUFFER_WHILE_TYPING);
-            semPost(1);
-        } else if (c == BACKSPACE_KEY && to_write != to_read) {
-            DEC_MOD(to_write, BUFFER_SIZE);
+            pushChar(queue, c, queue->options & SHOW_BUFFER_WHILE_TYPING);
+            if (readReady(queue)) // a canonical reader is only woken by a complete line
+                waitQueueWakeAll(queue->readers);
+        } else if (c == BACKSPACE_KEY && queue->to_write != queue->to_read) {
+            DEC_MOD(queue->to_write, BUFFER_SIZE);
             clearPreviousCharacter();
         }
     }
 
-    // Call the registered function for the key, if any
+    // Kernel handlers run here; a process' handler runs in that process
     RegisteredKeys *entry = getKeyFnEntry(keycode);
     if (entry != NULL && entry->fn != NULL) {
-        entry->fn(keycode);
+        if (entry->registered_from_kernel)
+            entry->fn(keycode);
+        else
+            queueKeyHandler(entry->owner, keycode);
     }
-    return scancode;
+}
+
+// Top half: only tracks modifiers, timestamps the event and captures the key for handleKey.
+// A key that does not fit in the deferred work queue is dropped, like one that does not
+// fit in the input buffer.
+uint8_t keyboardHandler(){
+    uint8_t scancode = getKeyboardBuffer();
+    uint8_t is_pressed = isPressed(scancode);
 
+    const uint8_t keycode = makeCode(scancode);
+
+    switch (keycode) {
+        case SHIFT_KEY_L:
+        case SHIFT_KEY_R:
+            SHIFT_KEY_PRESSED = is_pressed;
+            break;
+        case CONTROL_KEY_L:
+            CONTROL_KEY_PRESSED = is_pressed;
+            break;
+        case CAPS_LOCK_KEY:
+            if (is_pressed)
+                CAPS_LOCK_KEY_PRESSED = !CAPS_LOCK_KEY_PRESSED;
+            break;
+    }
+
+    if (IS_KEYCODE(keycode)) {
+        publishKeyEvent(keycode, is_pressed);
+    }
+
+    if (!(is_pressed && IS_KEYCODE(keycode))) {
+        return scancode; // ignore break or unsupported scancodes
+    }
+
+    int8_t c = scancodeMap[keycode][SHIFT_KEY_PRESSED];
+    if (CAPS_LOCK_KEY_PRESSED == 1) {
+        c = TO_UPPER(c);
+    }
+    deferWork(handleKey, KEY_WORK(keycode, c, IS_PRINTABLE(keycode) ? 1 : 0, CONTROL_KEY_PRESSED ? 1 : 0));
+    return scancode;
 }
+
@@ -0,0 +1,105 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <lib.h>
+#include <pat.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CPUID_FEATURES 1
+#define CPUID_EDX_PAT (1 << 16)
+#define IA32_PAT_MSR 0x277
+
+// Tipos de memoria de la PAT
+#define PAT_WRITE_COMBINING 0x01
+// Pure64 no usa PWT, así que la entrada 1 (PWT=1, PCD=0, PAT=0) queda libre para WC
+#define PAT_WC_INDEX 1
+
+#define PAGE_PRESENT (1ull << 0)
+#define PAGE_PWT (1ull << 3)
+#define PAGE_PCD (1ull << 4)
+#define PAGE_SIZE_BIT (1ull << 7) // En PDPTE/PDE: página grande
+#define PAGE_PAT_4K (1ull << 7)
+#define PAGE_PAT_LARGE (1ull << 12)
+#define TABLE_ADDRESS_MASK 0x000FFFFFFFFFF000ull
+
+#define PAGE_4K (1ull << 12)
+#define PAGE_2M (1ull << 21)
+#define PAGE_1G (1ull << 30)
+
+#define tableAt(entry) ((uint64_t *) ((entry) & TABLE_ADDRESS_MASK))
+#define tableIndex(address, shift) (((address) >> (shift)) & 0x1FF)
+
+static uint8_t patReady = 0;
+
+// Reprograma la entrada PAT_WC_INDEX de la PAT como write-combining
+static int8_t patInit(void) {
+	if (patReady)
+		return 0;
+	if (!(_cpuidEdx(CPUID_FEATURES) & CPUID_EDX_PAT))
+		return -1;
+	uint64_t pat = _rdmsr(IA32_PAT_MSR);
+	pat &= ~(0xFFull << (PAT_WC_INDEX * 8));
+	pat |= (uint64_t) PAT_WRITE_COMBINING << (PAT_WC_INDEX * 8);
+	_wbinvd();
+	_wrmsr(IA32_PAT_MSR, pat);
+	_wbinvd();
+	patReady = 1;
+	return 0;
+}
+
+// Entrada de la tabla que mapea `address` (identity map de Pure64) y tamaño de esa página
+static uint64_t *findPageEntry(uint64_t address, uint64_t *pageSize, uint64_t *patBit) {
+	uint64_t *pml4 = tableAt(_readCR3());
+	uint64_t *entry = &pml4[tableIndex(address, 39)];
+	if (!(*entry & PAGE_PRESENT))
+		return NULL;
+
+	entry = &tableAt(*entry)[tableIndex(address, 30)];
+	if (!(*entry & PAGE_PRESENT))
+		return NULL;
+	if (*entry & PAGE_SIZE_BIT) {
+		*pageSize = PAGE_1G;
+		*patBit = PAGE_PAT_LARGE;
+		return entry;
+	}
+
+	entry = &tableAt(*entry)[tableIndex(address, 21)];
+	if (!(*entry & PAGE_PRESENT))
+		return NULL;
+	if (*entry & PAGE_SIZE_BIT) {
+		*pageSize = PAGE_2M;
+		*patBit = PAGE_PAT_LARGE;
+		return entry;
+	}
+
+	entry = &tableAt(*entry)[tableIndex(address, 12)];
+	if (!(*entry & PAGE_PRESENT))
+		return NULL;
+	*pageSize = PAGE_4K;
+	*patBit = PAGE_PAT_4K;
+	return entry;
+}
+
+/*
+ * Las páginas del rango pasan a usar la entrada PAT_WC_INDEX. El tipo que pedía el
+ * MTRR (normalmente UC para la memoria de video) queda anulado: con PAT WC el tipo
+ * efectivo es WC, y las escrituras se juntan en líneas antes de salir al bus.
+ */
+int8_t setWriteCombining(uint64_t base, uint64_t size) {
+	if (size == 0 || patInit() == -1)
+		return -1;
+
+	uint64_t address = base;
+	while (address < base + size) {
+		uint64_t pageSize, patBit;
+		uint64_t *entry = findPageEntry(address, &pageSize, &patBit);
+		if (entry == NULL)
+			return -1;
+		uint64_t page = address & ~(pageSize - 1);
+		*entry = (*entry & ~(PAGE_PCD | patBit)) | PAGE_PWT;
+		_invlpg(page);
+		address = page + pageSize;
+	}
+	_wbinvd();
+	return 0;
+}
@@ -5,14 +5,33 @@
 #include <interrupts.h>
 
 #include <fonts.h>
+#include <video.h>
 #include<cursor.h>
+#include <deferred_work.h>
 
 static unsigned long ticks = 0;
+static uint8_t screen_work_pending = 0;
+
+#define FLUSH_SLICE_ROWS 64
+
+// Drawing the cursor and flushing the back buffer run in the deferred worker.
+// The flush goes a slice of rows at a time and lets interrupts in between slices,
+// so a full screen copy does not hold the timer off
+static void updateScreen(uint64_t arg) {
+	(void) arg;
+	screen_work_pending = 0;
+	toggleCursor();
+	while (videoFlushRows(FLUSH_SLICE_ROWS)) {
+		_sti(); // a pending interrupt is taken right after sti's one instruction shadow
+		_cli();
+	}
+}
 
 void timer_handler() {
 	ticks++;
 
-	toggleCursor();
+	if (!screen_work_pending && (cursorNeedsToggle() || videoIsDirty()) && deferWork(updateScreen, 0) == 0)
+		screen_work_pending = 1;
 }
 
 int ticks_elapsed() {
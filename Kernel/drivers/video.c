@@ -10,6 +10,10 @@
 
 #include <video.h>
 #include <interrupts.h>
+#include <stddef.h>
+#include <defs.h>
+#include <lib.h>
+#include <pat.h>
 
 struct vbe_mode_info_structure {
 	uint16_t attributes;		// deprecated, only bit 7 should be of interest to you, and it indicates the mode supports a linear frame buffer.
@@ -53,55 +57,532 @@ typedef struct vbe_mode_info_structure * VBEInfoPtr;
 
 VBEInfoPtr VBE_mode_info = (VBEInfoPtr) 0x0000000000005C00;
 
+#define MAX_SCREEN_HEIGHT 2048
+#define MAX_SCREEN_WIDTH 4096
+#define NO_DIRTY_ROW 0xFFFF
+#define NO_FRAMEBUFFER_OWNER (-1)
+#define BENCHMARK_ROUNDS 8
+#define MAX_CIRCLE_RADIUS (MAX_SCREEN_HEIGHT / 2)
+
+// Back buffer en RAM con el mismo formato que el framebuffer. Se dibuja ahí y
+// videoFlush copia al framebuffer solo los tramos de cada fila que cambiaron.
+// Mientras backBuffer sea NULL (antes de initVideo) se dibuja directo.
+static uint8_t * backBuffer = NULL;
+static uint32_t dirtyStart[MAX_SCREEN_HEIGHT]; // byte inicial del tramo sucio de cada fila
+static uint32_t dirtyEnd[MAX_SCREEN_HEIGHT];   // byte final (exclusivo); vacío si start >= end
+static uint16_t dirtyTop = NO_DIRTY_ROW, dirtyBottom = 0;
+// El back buffer es un anillo de filas: ringTop es la fila que se ve arriba de
+// la pantalla, así scrollear solo mueve ringTop y limpia las filas nuevas
+static uint16_t ringTop = 0;
+// Proceso que escribe directo al framebuffer. Mientras lo tiene, el flush queda
+// suspendido: lo que el kernel dibuje (p. ej. la salida de consola) se acumula en
+// el back buffer y aparece recién cuando lo devuelve
+static int32_t framebufferOwner = NO_FRAMEBUFFER_OWNER;
+
+static inline uint8_t * frontBuffer(void) {
+	return (uint8_t *)(uint64_t)(VBE_mode_info->framebuffer);
+}
+
+// Dirección de la fila y (de pantalla) en el buffer donde se dibuja
+static inline uint8_t * rowAddress(uint64_t y) {
+	if (backBuffer == NULL)
+		return frontBuffer() + y * VBE_mode_info->pitch;
+	uint64_t row = y + ringTop;
+	if (row >= VBE_mode_info->height)
+		row -= VBE_mode_info->height;
+	return backBuffer + row * VBE_mode_info->pitch;
+}
+
+static inline void moveQwords(void * dst, const void * src, uint64_t count) {
+	__asm__ volatile ("rep movsq" : "+D"(dst), "+S"(src), "+c"(count) : : "memory");
+}
+
+static inline void copyBytes(uint8_t * dst, const uint8_t * src, uint64_t length) {
+	moveQwords(dst, src, length / sizeof(uint64_t));
+	for (uint64_t i = length & ~7ull; i < length; i++)
+		dst[i] = src[i];
+}
+
+static inline void markDirty(uint64_t y, uint32_t fromByte, uint32_t toByte) {
+	if (backBuffer == NULL)
+		return;
+	if (dirtyStart[y] >= dirtyEnd[y]) {
+		dirtyStart[y] = fromByte;
+		dirtyEnd[y] = toByte;
+	} else {
+		if (fromByte < dirtyStart[y])
+			dirtyStart[y] = fromByte;
+		if (toByte > dirtyEnd[y])
+			dirtyEnd[y] = toByte;
+	}
+	if (y < dirtyTop)
+		dirtyTop = y;
+	if (y > dirtyBottom)
+		dirtyBottom = y;
+}
+
+static inline void markAllDirty(void) {
+	for (uint16_t y = 0; y < getWindowHeight(); y++)
+		markDirty(y, 0, VBE_mode_info->pitch);
+}
+
+/*
+ * Kernels de tramos horizontales, especializados por formato de pixel en initVideo.
+ * Los colores son 0x00RRGGBB, que en memoria (little endian) queda B, G, R: a 32bpp
+ * un pixel es una palabra de 4 bytes, y a 24bpp 4 pixeles son 3 palabras de 4 bytes.
+ */
+typedef uint32_t __attribute__((may_alias, aligned(1))) unaligned_u32;
+typedef uint16_t __attribute__((may_alias, aligned(1))) unaligned_u16;
+
+typedef struct SpanKernels {
+	void (*fill)(uint8_t * dst, uint32_t color, uint64_t count);
+	void (*copy)(uint8_t * dst, const uint32_t * src, uint64_t count);
+	// Bit i de mask (LSB primero) elige fg o bg para el pixel i
+	void (*mask)(uint8_t * dst, const uint8_t * mask, uint64_t count, uint32_t fg, uint32_t bg);
+} SpanKernels;
+
+static inline void storePixel24(uint8_t * dst, uint32_t color) {
+	*(unaligned_u16 *) dst = (uint16_t) color;
+	dst[2] = (uint8_t) (color >> 16);
+}
+
+static void fillSpan32(uint8_t * dst, uint32_t color, uint64_t count) {
+	color &= 0x00FFFFFF;
+	if (((uint64_t) dst & 7) != 0 && count > 0) {
+		*(unaligned_u32 *) dst = color;
+		dst += 4;
+		count--;
+	}
+	uint64_t pattern = ((uint64_t) color << 32) | color;
+	uint64_t qwords = count / 2;
+	__asm__ volatile ("rep stosq" : "+D"(dst), "+c"(qwords) : "a"(pattern) : "memory");
+	if (count & 1)
+		*(unaligned_u32 *) dst = color;
+}
+
+static void fillSpan24(uint8_t * dst, uint32_t color, uint64_t count) {
+	color &= 0x00FFFFFF;
+	uint32_t w0 = color | (color << 24);		 // B G R B
+	uint32_t w1 = (color >> 8) | (color << 16);	 // G R B G
+	uint32_t w2 = (color >> 16) | (color << 8);	 // R B G R
+	for (; count >= 4; count -= 4, dst += 12) {
+		unaligned_u32 * words = (unaligned_u32 *) dst;
+		words[0] = w0;
+		words[1] = w1;
+		words[2] = w2;
+	}
+	for (; count > 0; count--, dst += 3)
+		storePixel24(dst, color);
+}
+
+static void copySpan32(uint8_t * dst, const uint32_t * src, uint64_t count) {
+	moveQwords(dst, src, count / 2);
+	if (count & 1)
+		*(unaligned_u32 *) (dst + (count - 1) * 4) = src[count - 1];
+}
+
+static void copySpan24(uint8_t * dst, const uint32_t * src, uint64_t count) {
+	for (; count >= 4; count -= 4, dst += 12, src += 4) {
+		uint32_t p0 = src[0] & 0x00FFFFFF, p1 = src[1] & 0x00FFFFFF;
+		uint32_t p2 = src[2] & 0x00FFFFFF, p3 = src[3] & 0x00FFFFFF;
+		unaligned_u32 * words = (unaligned_u32 *) dst;
+		words[0] = p0 | (p1 << 24);
+		words[1] = (p1 >> 8) | (p2 << 16);
+		words[2] = (p2 >> 16) | (p3 << 8);
+	}
+	for (; count > 0; count--, dst += 3)
+		storePixel24(dst, *src++);
+}
+
+static void maskSpan32(uint8_t * dst, const uint8_t * mask, uint64_t count, uint32_t fg, uint32_t bg) {
+	unaligned_u32 * pixels = (unaligned_u32 *) dst;
+	for (uint64_t i = 0; i < count; i++)
+		pixels[i] = (mask[i >> 3] & (1 << (i & 7))) ? fg : bg;
+}
+
+static void maskSpan24(uint8_t * dst, const uint8_t * mask, uint64_t count, uint32_t fg, uint32_t bg) {
+	for (uint64_t i = 0; i < count; i++, dst += 3)
+		storePixel24(dst, (mask[i >> 3] & (1 << (i & 7))) ? fg : bg);
+}
+
+static const SpanKernels spans24 = {fillSpan24, copySpan24, maskSpan24};
+static const SpanKernels spans32 = {fillSpan32, copySpan32, maskSpan32};
+static const SpanKernels * spans = &spans24;
+static uint8_t bytesPerPixel = 3;
+
+void initVideo(void) {
+	bytesPerPixel = VBE_mode_info->bpp >> 3;
+	spans = bytesPerPixel == 4 ? &spans32 : &spans24;
+
+	uint64_t size = (uint64_t) VBE_mode_info->pitch * VBE_mode_info->height;
+	if (VBE_mode_info->height > MAX_SCREEN_HEIGHT || VBE_mode_info->width > MAX_SCREEN_WIDTH || size > BACK_BUFFER_MAX_SIZE)
+		return; // Modo demasiado grande: se sigue dibujando directo al framebuffer
+
+	// Arranca con lo que ya hay en pantalla
+	moveQwords((void *) BACK_BUFFER_ADDRESS, frontBuffer(), size / sizeof(uint64_t));
+	ringTop = 0;
+	for (uint16_t y = 0; y < MAX_SCREEN_HEIGHT; y++)
+		dirtyStart[y] = dirtyEnd[y] = 0;
+	backBuffer = (uint8_t *) BACK_BUFFER_ADDRESS;
+}
+
+uint8_t videoIsDirty(void) {
+	return backBuffer != NULL && dirtyTop != NO_DIRTY_ROW && framebufferOwner == NO_FRAMEBUFFER_OWNER;
+}
+
+// Copia los tramos sucios de a 8 bytes. Los extremos se redondean a 8: el
+// pitch del modo VBE es múltiplo de 8, así que nunca se pasa de la fila.
+// Avanza dirtyTop fila por fila, así entre dos llamadas el estado queda
+// consistente y lo que se marque mientras tanto se copia en la siguiente
+uint8_t videoFlushRows(uint16_t maxRows) {
+	if (backBuffer == NULL || framebufferOwner != NO_FRAMEBUFFER_OWNER)
+		return 0;
+	uint16_t pitch = VBE_mode_info->pitch;
+	uint8_t * framebuffer = frontBuffer();
+	uint16_t copied = 0;
+	while (dirtyTop != NO_DIRTY_ROW && copied < maxRows) {
+		uint16_t y = dirtyTop;
+		if (dirtyStart[y] < dirtyEnd[y]) {
+			uint32_t from = dirtyStart[y] & ~7u;
+			uint32_t to = (dirtyEnd[y] + 7) & ~7u;
+			if (to > pitch)
+				to = pitch;
+			moveQwords(framebuffer + (uint64_t) y * pitch + from, rowAddress(y) + from, (to - from) / sizeof(uint64_t));
+			dirtyStart[y] = dirtyEnd[y] = 0;
+			copied++;
+		}
+		if (y >= dirtyBottom) {
+			dirtyTop = NO_DIRTY_ROW;
+			dirtyBottom = 0;
+		} else {
+			dirtyTop = y + 1;
+		}
+	}
+	return dirtyTop != NO_DIRTY_ROW;
+}
+
+void videoFlush(void) {
+	videoFlushRows(MAX_SCREEN_HEIGHT);
+}
+
 void putPixel(uint32_t hexColor, uint64_t x, uint64_t y) {
-    uint8_t * framebuffer = (uint8_t * )(unsigned long long)(VBE_mode_info->framebuffer);
-    uint64_t offset = (x * ((VBE_mode_info->bpp) >> 3)) + (y * VBE_mode_info->pitch);
-	uint8_t b = (hexColor) & 0xFF, g = (hexColor >> 8) & 0xFF, r = (hexColor >> 16) & 0xFF;
+	uint32_t offset = x * bytesPerPixel;
+	spans->fill(rowAddress(y) + offset, hexColor, 1);
+	markDirty(y, offset, offset + bytesPerPixel);
+}
+
+void expandMask(uint8_t * dst, const uint8_t * mask, uint64_t count, uint32_t fg, uint32_t bg) {
+	spans->mask(dst, mask, count, fg, bg);
+}
 
-    framebuffer[offset]     =  b;
-    framebuffer[offset+1]   =  g;
-    framebuffer[offset+2]   =  r;
+// `pixels` ya viene en el formato del framebuffer (getBytesPerPixel bytes por pixel)
+void drawRow(const uint8_t * pixels, uint64_t x, uint64_t y, uint64_t width) {
+	uint16_t screenWidth = getWindowWidth();
+	if (y >= getWindowHeight() || x >= screenWidth)
+		return;
+	if (x + width > screenWidth)
+		width = screenWidth - x;
+	copyBytes(rowAddress(y) + x * bytesPerPixel, pixels, width * bytesPerPixel);
+	markDirty(y, x * bytesPerPixel, (x + width) * bytesPerPixel);
 }
 
 void drawRectangle(uint32_t hexColor, uint64_t width, uint64_t height, uint64_t initial_pos_x, uint64_t initial_pos_y){
+	if (initial_pos_x >= getWindowWidth() || initial_pos_y >= getWindowHeight())
+		return;
+	if (initial_pos_x + width > getWindowWidth())
+		width = getWindowWidth() - initial_pos_x;
+	if (initial_pos_y + height > getWindowHeight())
+		height = getWindowHeight() - initial_pos_y;
+
+	uint32_t from = initial_pos_x * bytesPerPixel, to = (initial_pos_x + width) * bytesPerPixel;
 	for(uint64_t y = initial_pos_y; y - initial_pos_y < height; y++){
-		for(uint64_t x = initial_pos_x; x - initial_pos_x < width; x++){
-			putPixel(hexColor, x, y);
+		spans->fill(rowAddress(y) + from, hexColor, width);
+		markDirty(y, from, to);
+	}
+}
+
+// Pinta [fromX, toX] de la fila y, recortado a la pantalla
+static inline void fillClippedSpan(uint32_t hexColor, int64_t fromX, int64_t toX, int64_t y) {
+	if (y < 0 || y >= getWindowHeight() || toX < 0 || fromX >= getWindowWidth())
+		return;
+	if (fromX < 0)
+		fromX = 0;
+	if (toX >= getWindowWidth())
+		toX = getWindowWidth() - 1;
+	if (fromX > toX)
+		return;
+	spans->fill(rowAddress(y) + fromX * bytesPerPixel, hexColor, toX - fromX + 1);
+	markDirty(y, fromX * bytesPerPixel, (toX + 1) * bytesPerPixel);
+}
+
+// Algoritmo del punto medio: halfWidth[dy] es el mayor dx dentro del círculo de
+// radio `radius` a dy filas del centro. Cada paso del octante da una fila de cada
+// mitad, así que todo sale de sumas enteras, sin multiplicar por pixel.
+static void circleHalfWidths(int64_t radius, int16_t * halfWidth) {
+	for (int64_t i = 0; i <= radius; i++)
+		halfWidth[i] = -1;
+	int64_t x = radius, y = 0, error = 1 - radius;
+	while (x >= y) {
+		if (halfWidth[y] < x)
+			halfWidth[y] = x;
+		if (halfWidth[x] < y)
+			halfWidth[x] = y;
+		y++;
+		if (error < 0) {
+			error += 2 * y + 1;
+		} else {
+			x--;
+			error += 2 * (y - x) + 1;
 		}
 	}
 }
 
+static int16_t outerHalfWidth[MAX_CIRCLE_RADIUS + 1];
+static int16_t innerHalfWidth[MAX_CIRCLE_RADIUS + 1];
+
+// El círculo ocupa la caja de diameter x diameter que empieza en (topLeftX, topLeftY):
+// se descartan la última fila y la última columna del círculo de 2 * radius + 1, como
+// hacía el dibujo pixel a pixel, así la comida de la víbora no se sale de su celda
+#define lastRow(center, radius) ((center) + (radius) - 1)
+#define clipRight(center, dx, radius) ((center) + ((dx) < (radius) ? (dx) : (radius) - 1))
+
 void drawCircle(uint32_t hexColor, uint64_t topLeftX, uint64_t topLeftY, uint64_t diameter) {
-    int64_t radius = diameter / 2;
-    int64_t centerX = topLeftX + radius;
-    int64_t centerY = topLeftY + radius;
-    
-    for (int64_t y = -radius; y < radius; y++) {
-        for (int64_t x = -radius; x < radius; x++) {
-            if (x * x + y * y <= radius * radius) {
-                putPixel(hexColor, centerX + x, centerY + y);
-            }
-        }
-    }
+	int64_t radius = diameter / 2;
+	if (radius > MAX_CIRCLE_RADIUS)
+		radius = MAX_CIRCLE_RADIUS;
+	int64_t centerX = topLeftX + radius;
+	int64_t centerY = topLeftY + radius;
+
+	circleHalfWidths(radius, outerHalfWidth);
+	for (int64_t dy = 0; dy <= radius; dy++) {
+		int64_t dx = outerHalfWidth[dy];
+		if (centerY + dy <= lastRow(centerY, radius))
+			fillClippedSpan(hexColor, centerX - dx, clipRight(centerX, dx, radius), centerY + dy);
+		if (dy != 0)
+			fillClippedSpan(hexColor, centerX - dx, clipRight(centerX, dx, radius), centerY - dy);
+	}
+}
+
+// Anillo de `thickness` pixeles: por fila, lo que hay entre el círculo exterior y el interior
+void drawCircleOutline(uint32_t hexColor, uint64_t topLeftX, uint64_t topLeftY, uint64_t diameter, uint64_t thickness) {
+	int64_t radius = diameter / 2;
+	if (radius > MAX_CIRCLE_RADIUS)
+		radius = MAX_CIRCLE_RADIUS;
+	if (thickness == 0)
+		return;
+	if ((int64_t) thickness > radius) {
+		drawCircle(hexColor, topLeftX, topLeftY, radius * 2);
+		return;
+	}
+	int64_t innerRadius = radius - thickness;
+	int64_t centerX = topLeftX + radius;
+	int64_t centerY = topLeftY + radius;
+
+	circleHalfWidths(radius, outerHalfWidth);
+	circleHalfWidths(innerRadius, innerHalfWidth);
+	for (int64_t dy = 0; dy <= radius; dy++) {
+		int64_t outer = outerHalfWidth[dy];
+		int64_t inner = dy <= innerRadius ? innerHalfWidth[dy] : -1;
+		for (int64_t side = -1; side <= 1; side += 2) {
+			if (dy == 0 && side == -1)
+				continue;
+			int64_t y = centerY + side * dy;
+			if (y > lastRow(centerY, radius))
+				continue;
+			if (inner < 0) {
+				fillClippedSpan(hexColor, centerX - outer, clipRight(centerX, outer, radius), y);
+			} else {
+				fillClippedSpan(hexColor, centerX - outer, centerX - inner - 1, y);
+				fillClippedSpan(hexColor, centerX + inner + 1, clipRight(centerX, outer, radius), y);
+			}
+		}
+	}
+}
+
+// Las esquinas son cuartos del círculo de radio `radius`; el resto son filas completas
+void drawRoundedRectangle(uint32_t hexColor, uint64_t width, uint64_t height, uint64_t x, uint64_t y, uint64_t radius) {
+	if (width == 0 || height == 0)
+		return;
+	uint64_t maxRadius = (width < height ? width : height) / 2;
+	if (radius > maxRadius)
+		radius = maxRadius;
+	if (radius > MAX_CIRCLE_RADIUS)
+		radius = MAX_CIRCLE_RADIUS;
+
+	circleHalfWidths(radius, outerHalfWidth);
+	int64_t left = x, right = x + width - 1;
+	for (uint64_t j = 0; j < height; j++) {
+		uint64_t fromEdge = j < height / 2 ? j : height - 1 - j;
+		int64_t inset = fromEdge < radius ? radius - outerHalfWidth[radius - fromEdge] : 0;
+		fillClippedSpan(hexColor, left + inset, right - inset, y + j);
+	}
 }
 
 
 void fillVideoMemory(uint32_t hexColor) {
-	uint8_t * framebuffer = (uint8_t * )(unsigned long long)(VBE_mode_info->framebuffer);
 	uint16_t width = getWindowWidth();
 	uint16_t height = getWindowHeight();
 
-	uint8_t b = (hexColor) & 0xFF, g = (hexColor >> 8) & 0xFF, r = (hexColor >> 16) & 0xFF;
-	uint64_t yoffset;
 	for (uint16_t y = 0; y < height; y++) {
-		yoffset = (y * VBE_mode_info->pitch);
-		for (uint16_t x = 0; x < width; x++) {
-			uint64_t offset = (x * ((VBE_mode_info->bpp) >> 3)) + yoffset;
-			framebuffer[offset] = b;
-			framebuffer[offset + 1] = g;
-			framebuffer[offset + 2] = r;
+		spans->fill(rowAddress(y), hexColor, width);
+	}
+	markAllDirty();
+}
+
+void drawBitmap(const uint32_t * pixels, uint64_t x, uint64_t y, uint64_t width, uint64_t height) {
+	Blit blit = {.pixels = pixels, .stride = width * sizeof(uint32_t), .width = width, .height = height, .bpp = 32, .scale = 1, .x = x, .y = y};
+	blitImage(&blit);
+}
+
+// Fila del origen ya escalada y recortada, en 0x00RRGGBB
+static uint32_t blitLine[MAX_SCREEN_WIDTH];
+
+static inline uint32_t sourcePixel(const uint8_t * row, uint64_t column, uint8_t bpp) {
+	if (bpp == 32)
+		return ((const uint32_t *) row)[column] & 0x00FFFFFF;
+	const uint8_t * pixel = row + column * 3;
+	return pixel[0] | (pixel[1] << 8) | ((uint32_t) pixel[2] << 16);
+}
+
+/*
+ * Cada fila del origen se convierte una sola vez a blitLine (escalada a lo ancho y
+ * recortada) y se reutiliza para las `scale` filas de destino que le tocan. Sin color
+ * transparente es una copia por fila; con color, una copia por tramo opaco.
+ */
+int8_t blitImage(const Blit * blit) {
+	if (blit == NULL || blit->pixels == NULL || blit->scale == 0 ||
+		(blit->bpp != 24 && blit->bpp != 32) || blit->stride < (uint32_t) blit->width * (blit->bpp >> 3))
+		return -1;
+
+	int64_t scale = blit->scale;
+	int64_t left = blit->x, top = blit->y;
+	int64_t right = left + blit->width * scale, bottom = top + blit->height * scale; // exclusivos
+	int64_t fromX = left < 0 ? 0 : left;
+	int64_t toX = right > getWindowWidth() ? getWindowWidth() : right;
+	int64_t fromY = top < 0 ? 0 : top;
+	int64_t toY = bottom > getWindowHeight() ? getWindowHeight() : bottom;
+	if (fromX >= toX || fromY >= toY)
+		return 0;
+
+	// blitLine tiene lugar para MAX_SCREEN_WIDTH pixeles, aunque la pantalla sea más ancha
+	if (toX - fromX > MAX_SCREEN_WIDTH)
+		toX = fromX + MAX_SCREEN_WIDTH;
+	uint64_t visible = toX - fromX;
+	uint32_t colorKey = blit->colorKey & 0x00FFFFFF; // blitLine viene en 0x00RRGGBB
+	int64_t lastSourceRow = -1;
+	for (int64_t y = fromY; y < toY; y++) {
+		int64_t sourceRow = (y - top) / scale;
+		if (sourceRow != lastSourceRow) {
+			const uint8_t * row = (const uint8_t *) blit->pixels + (uint64_t) sourceRow * blit->stride;
+			for (uint64_t i = 0; i < visible; i++)
+				blitLine[i] = sourcePixel(row, (fromX + i - left) / scale, blit->bpp);
+			lastSourceRow = sourceRow;
+		}
+
+		uint8_t * destination = rowAddress(y) + fromX * bytesPerPixel;
+		if (!(blit->flags & BLIT_COLOR_KEY)) {
+			spans->copy(destination, blitLine, visible);
+		} else {
+			uint64_t i = 0;
+			while (i < visible) {
+				while (i < visible && blitLine[i] == colorKey)
+					i++;
+				uint64_t start = i;
+				while (i < visible && blitLine[i] != colorKey)
+					i++;
+				if (i > start)
+					spans->copy(destination + start * bytesPerPixel, blitLine + start, i - start);
+			}
+		}
+		markDirty(y, fromX * bytesPerPixel, toX * bytesPerPixel);
+	}
+	return 0;
+}
+
+int64_t drawCommands(const DrawCommand * commands, uint64_t count, uint8_t flags) {
+	if (commands == NULL || count > MAX_DRAW_COMMANDS)
+		return -1;
+	for (uint64_t i = 0; i < count; i++) {
+		if (commands[i].type >= DRAW_COMMAND_TYPES || (commands[i].type == DRAW_BITMAP && commands[i].pixels == NULL))
+			return -1;
+	}
+
+	for (uint64_t i = 0; i < count; i++) {
+		const DrawCommand * command = &commands[i];
+		switch (command->type) {
+			case DRAW_RECTANGLE:
+				drawRectangle(command->color, command->width, command->height, command->x, command->y);
+				break;
+			case DRAW_CIRCLE:
+				drawCircle(command->color, command->x, command->y, command->width);
+				break;
+			case DRAW_FILL:
+				fillVideoMemory(command->color);
+				break;
+			case DRAW_BITMAP:
+				drawBitmap(command->pixels, command->x, command->y, command->width, command->height);
+				break;
+			case DRAW_CIRCLE_OUTLINE:
+				drawCircleOutline(command->color, command->x, command->y, command->width, command->thickness);
+				break;
+			case DRAW_ROUNDED_RECTANGLE:
+				drawRoundedRectangle(command->color, command->width, command->height, command->x, command->y, command->radius);
+				break;
 		}
 	}
+	if (flags & DRAW_FLUSH)
+		videoFlush();
+	return count;
+}
+
+int8_t acquireFramebuffer(int32_t owner, FramebufferInfo * info) {
+	// Sin back buffer la consola dibuja directo y no se la puede apartar
+	if (info == NULL || backBuffer == NULL || (framebufferOwner != NO_FRAMEBUFFER_OWNER && framebufferOwner != owner))
+		return -1;
+	videoFlush(); // El dueño arranca viendo lo que ya estaba dibujado
+	framebufferOwner = owner;
+	info->address = frontBuffer();
+	info->pitch = VBE_mode_info->pitch;
+	info->width = VBE_mode_info->width;
+	info->height = VBE_mode_info->height;
+	info->bpp = VBE_mode_info->bpp;
+	return 0;
+}
+
+int8_t releaseFramebuffer(int32_t owner) {
+	if (owner == NO_FRAMEBUFFER_OWNER || owner != framebufferOwner)
+		return -1;
+	framebufferOwner = NO_FRAMEBUFFER_OWNER;
+	markAllDirty();
+	videoFlush();
+	return 0;
+}
+
+int8_t videoEnableWriteCombining(void) {
+	return setWriteCombining((uint64_t) frontBuffer(), (uint64_t) VBE_mode_info->pitch * VBE_mode_info->height);
+}
+
+// Llena la pantalla BENCHMARK_ROUNDS veces directo en el framebuffer y mide con el TSC.
+// Ciclos / MHz = microsegundos, así que bytes * MHz / ciclos da MB/s
+uint64_t videoFillBandwidth(uint32_t hexColor) {
+	uint16_t mhz = *(uint16_t *) CPU_SPEED_MHZ_ADDRESS;
+	uint16_t width = getWindowWidth(), height = getWindowHeight();
+	uint16_t pitch = VBE_mode_info->pitch;
+	uint8_t * framebuffer = frontBuffer();
+
+	uint64_t start = _rdtsc();
+	for (uint8_t round = 0; round < BENCHMARK_ROUNDS; round++)
+		for (uint16_t y = 0; y < height; y++)
+			spans->fill(framebuffer + (uint64_t) y * pitch, hexColor, width);
+	uint64_t cycles = _rdtsc() - start;
+
+	markAllDirty(); // El próximo flush vuelve a mostrar el back buffer
+	uint64_t bytes = (uint64_t) BENCHMARK_ROUNDS * height * width * bytesPerPixel;
+	return cycles == 0 ? 0 : bytes * mhz / cycles;
+}
+
+uint8_t getBytesPerPixel(void) {
+	return bytesPerPixel;
 }
 
 uint16_t getWindowHeight() {
@@ -112,40 +593,29 @@ uint16_t getWindowWidth() {
 	return VBE_mode_info->width;
 }
 
+// Con back buffer el scroll es O(filas nuevas): se corre el anillo y se limpian
+// las filas que aparecen abajo. La copia al framebuffer la hace el próximo flush,
+// que junta varios scrolls en uno. Sin back buffer, es una sola copia de las
+// filas contiguas con rep movsq.
 void scrollVideoMemoryUp(uint16_t scroll, uint32_t fillColor) {
-	_cli();
-
-	uint8_t * framebuffer = (uint8_t * )(unsigned long long)(VBE_mode_info->framebuffer);
 	uint16_t width = getWindowWidth();
 	uint16_t height = getWindowHeight();
-	
-	uint8_t b = (fillColor) & 0xFF, g = (fillColor >> 8) & 0xFF, r = (fillColor >> 16) & 0xFF;
-
-	// Iterating over Y, then X
-	// -> Memory is contiguous in the framebuffer, increased cached hits, reduced tearing
-	uint64_t yoffset, ynoffset, offset, new_offset, xo;
-	for (uint16_t y = 0; y < height - scroll; y++) {
-		yoffset = (y * VBE_mode_info->pitch);
-		ynoffset = ((y + scroll) * VBE_mode_info->pitch);
-		for (uint16_t x = 0; x < width; x++) {
-			xo = (x * ((VBE_mode_info->bpp) >> 3));
-			offset = xo + yoffset;
-			new_offset = xo + ynoffset;
-			framebuffer[offset] = framebuffer[new_offset];
-			framebuffer[offset + 1] = framebuffer[new_offset + 1];
-			framebuffer[offset + 2] = framebuffer[new_offset + 2];
-		}
+	if (scroll > height)
+		scroll = height;
+
+	uint64_t flags = _cliSave();
+
+	if (backBuffer != NULL) {
+		ringTop = (ringTop + scroll) % height;
+	} else {
+		uint64_t pitch = VBE_mode_info->pitch;
+		copyBytes(frontBuffer(), frontBuffer() + scroll * pitch, (height - scroll) * pitch);
 	}
 
 	for (uint16_t y = height - scroll; y < height; y++) {
-		yoffset = (y * VBE_mode_info->pitch);
-		for (uint16_t x = 0; x < width; x++) {
-			offset = (x * ((VBE_mode_info->bpp) >> 3)) + yoffset;
-			framebuffer[offset] = b;
-			framebuffer[offset + 1] = g;
-			framebuffer[offset + 2] = r;
-		}
+		spans->fill(rowAddress(y), fillColor, width);
 	}
+	markAllDirty();
 
-	_sti();
+	_restoreFlags(flags);
 }
@@ -11,6 +11,7 @@
 #include <fonts.h>
 #include <keyboard.h>
 #include <video.h>
+#include <defs.h>
 
 /* 
     Note: An attempt was made to use the Linux kernel's Solarize.12x29.psf (https://wiki.osdev.org/PC_Screen_Font). Now only the pain remains.
@@ -35,7 +36,31 @@
 #define FD_STDERR 2
 #define DEV_NULL (-1)
 
-#define MAX(a,b) ((a) > (b) ? (a) : (b))
+
+#define MIN_FONT_SIZE 1
+#define MAX_FONT_SIZE 10
+#define MAX_BYTES_PER_PIXEL 4
+#define GLYPH_ROW_PATTERNS 256
+#define EXPANDED_ROW_SIZE (DEFAULT_GLYPH_SIZE_X * MAX_FONT_SIZE * MAX_BYTES_PER_PIXEL)
+
+// The console is a grid of cells; pixels are only a rendering of it
+#define MAX_COLUMNS 256
+#define MAX_ROWS 160
+
+// VT100/ANSI escape sequences: ESC [ params final
+#define ANSI_MAX_PARAMS 8
+#define ANSI_PALETTE_SIZE 16
+
+#define cellWidth() (glyphSizeX * fontSize)
+#define cellHeight() (glyphSizeY * fontSize)
+#define lineIndex(row) ((gridTop + (row)) % MAX_ROWS)
+
+typedef struct Cell {
+    uint32_t fg;
+    uint32_t bg;
+    char ascii;
+    uint8_t damaged;
+} Cell;
 
 static uint16_t glyphSizeX = DEFAULT_GLYPH_SIZE_X;
 static uint16_t glyphSizeY = DEFAULT_GLYPH_SIZE_Y;
@@ -43,17 +68,55 @@ static uint16_t fontSize = 1;
 
 static char * bitmap = (char *) font8x8_basic;
 
-static int32_t xBufferPosition;
-static int32_t yBufferPosition;
-
-static uint16_t maxGlyphSizeYOnLine = DEFAULT_GLYPH_SIZE_Y;
+/*
+ * The grid is a ring of lines: gridTop is the line shown at the top of the screen.
+ * Scrolling advances gridTop and rotates the video ring by one cell height, so the
+ * cells keep their rendered pixels and only the damaged ones are redrawn.
+ * It lives next to the back buffer instead of the kernel's bss, and is cleared the
+ * first time the grid is sized.
+ */
+static Cell (* const grid)[MAX_COLUMNS] = (Cell (*)[MAX_COLUMNS]) CONSOLE_GRID_ADDRESS;
+static uint8_t lineDamaged[MAX_ROWS];
+static uint16_t damagedLines = 0;
+static uint16_t gridTop = 0;
+static uint16_t columns = 0;
+static uint16_t rows = 0;
 
-static uint8_t dirty_line;
+static uint16_t cursorColumn;
+static uint16_t cursorRow;
 
 static uint32_t text_color = DEFAULT_TEXT_COLOR;
 static uint32_t background_color = DEFAULT_BACKGROUND_COLOR;
 static uint8_t file_descriptor = FD_STDOUT;
 
+typedef enum { ANSI_NORMAL, ANSI_ESCAPE, ANSI_CSI } AnsiState;
+
+/*
+ * The escape parser keeps its state between writes, so a sequence split across
+ * several sys_write calls (e.g. printf writing one char at a time) still works.
+ */
+static AnsiState ansiState = ANSI_NORMAL;
+static uint16_t ansiParams[ANSI_MAX_PARAMS];
+static uint8_t ansiParamCount;
+
+// SGR 30-37 / 90-97 (and their background counterparts), in that order
+static const uint32_t ansiPalette[ANSI_PALETTE_SIZE] = {
+    0x00000000, 0x00DE382B, 0x0039B54A, 0x00FFC706, 0x00006FB8, 0x00762671, 0x002CB5E9, 0x00CCCCCC,
+    0x00808080, 0x00FF0000, 0x0000FF00, 0x00FFFF00, 0x000000FF, 0x00FF00FF, 0x0000FFFF, 0x00FFFFFF
+};
+
+/*
+ * Glyph cache: every row of an 8x8 glyph is one byte of the bitmap, so the expanded
+ * row (fontSize pixels per bit, already in framebuffer format) only depends on that
+ * byte and on the size/colors being rendered. Rows are expanded lazily and shared
+ * between all glyphs; bumping cacheGeneration invalidates every entry at once.
+ */
+static uint8_t (* const expandedRows)[EXPANDED_ROW_SIZE] = (uint8_t (*)[EXPANDED_ROW_SIZE]) GLYPH_CACHE_ADDRESS;
+static uint32_t expandedRowGeneration[GLYPH_ROW_PATTERNS];
+static uint32_t cacheGeneration = 1;
+static uint32_t cacheFg, cacheBg;
+static uint16_t cacheFontSize = 0;
+
 void setTextColor(uint32_t color) {
     text_color = color;
 }
@@ -71,83 +134,385 @@ uint32_t getBackgroundColor(void) {
 }
 
 uint16_t getXBufferPosition(void) {
-    return xBufferPosition;
+    return cursorColumn * cellWidth();
 }
 
 static char buffer[64] = { 0 };
 
-static inline void renderFromBitmap(char * bitmap, uint64_t xBase, uint64_t yBase);
-static inline void renderAscii(char ascii, uint64_t x, uint64_t y);
+static inline void renderFromBitmap(char * bitmap, uint64_t xBase, uint64_t yBase, uint32_t fg, uint32_t bg);
+static inline void renderCell(const Cell * cell, uint16_t column, uint16_t row);
+static void renderDamage(void);
+static void writeChar(char ascii);
+static void consumeChar(char ascii);
+static void resizeGrid(uint8_t size);
 
 void showCursor(void);
 void hideCursor(void);
-static void scrollBufferPositionIfNeeded(void);
 void clearPreviousCharacter(void);
 
 static uint32_t uintToBase(uint64_t value, char * buffer, uint32_t base);
 static void printBase(uint64_t value, uint32_t base);
 static inline int64_t kstrlen(const char * str);
 
+static const uint8_t * expandedRow(uint8_t pattern, uint32_t fg, uint32_t bg) {
+    if (fg != cacheFg || bg != cacheBg || fontSize != cacheFontSize) {
+        cacheFg = fg;
+        cacheBg = bg;
+        cacheFontSize = fontSize;
+        cacheGeneration++;
+    }
+    uint8_t * row = expandedRows[pattern];
+    if (expandedRowGeneration[pattern] == cacheGeneration) {
+        return row;
+    }
+
+    // Scales the bitmap row to fontSize bits per pixel and lets the video driver expand it
+    uint8_t mask[EXPANDED_ROW_SIZE / MAX_BYTES_PER_PIXEL / 8] = { 0 };
+    for (int bit = 0; bit < glyphSizeX * fontSize; bit++) {
+        if (pattern & (1 << (bit / fontSize))) {
+            mask[bit >> 3] |= 1 << (bit & 7);
+        }
+    }
+    expandMask(row, mask, glyphSizeX * fontSize, fg, bg);
+    expandedRowGeneration[pattern] = cacheGeneration;
+    return row;
+}
+
 // * Uses inline to avoid stack frames on hot paths *
-static inline void renderFromBitmap(char * bitmap, uint64_t xBase, uint64_t yBase) {
-    int xs, xo;
-    for (int x = 0; x < glyphSizeX * fontSize; x++) {
-        xs = xBase + x;
-        xo = x / fontSize;
-        for (int y = 0; y < glyphSizeY * fontSize; y++) {
-            // Read into char * slice and mask
-            putPixel(*(bitmap + (y / fontSize)) & (1 << xo) ? text_color : background_color, xs, yBase + y);
+// Row-major: each glyph row is fetched from the cache and copied fontSize times
+static inline void renderFromBitmap(char * bitmap, uint64_t xBase, uint64_t yBase, uint32_t fg, uint32_t bg) {
+    uint64_t width = cellWidth();
+    uint64_t y = yBase;
+    for (int yo = 0; yo < glyphSizeY; yo++) {
+        const uint8_t * row = expandedRow((uint8_t) bitmap[yo], fg, bg);
+        for (int i = 0; i < fontSize; i++, y++) {
+            drawRow(row, xBase, y, width);
         }
     }
 }
 
 // * Uses inline to avoid stack frames on hot paths *
-// `x` and `y` are the TOP LEFT corner positions
-static inline void renderAscii(char ascii, uint64_t x, uint64_t y) {
-    if ((unsigned char)ascii < 128) {
-        uint8_t glyph = (uint8_t)ascii;
-        // The function only takes in a slice of the whole matrix
-        renderFromBitmap(bitmap + (glyph * glyphSizeY), x, y);
+// Characters outside the font (128-255) are drawn as blanks
+static inline void renderCell(const Cell * cell, uint16_t column, uint16_t row) {
+    uint8_t glyph = (unsigned char) cell->ascii < 128 ? (uint8_t) cell->ascii : ' ';
+    // The function only takes in a slice of the whole matrix
+    renderFromBitmap(bitmap + (glyph * glyphSizeY), column * cellWidth(), row * cellHeight(), cell->fg, cell->bg);
+}
+
+static inline uint8_t isBlank(const Cell * cell) {
+    return (cell->ascii == ' ' || cell->ascii == 0) && cell->bg == DEFAULT_BACKGROUND_COLOR;
+}
+
+static inline void damageCell(uint16_t line, Cell * cell) {
+    cell->damaged = 1;
+    if (!lineDamaged[line]) {
+        lineDamaged[line] = 1;
+        damagedLines++;
     }
 }
 
-static void scrollBufferPositionIfNeeded(void) {
-    if (yBufferPosition + glyphSizeY * fontSize > getWindowHeight()) {
-        scrollVideoMemoryUp(glyphSizeY * fontSize, DEFAULT_BACKGROUND_COLOR);
-        yBufferPosition -= glyphSizeY * fontSize;
+// Leaves the line blank and clean: callers have already painted it with the background
+static void clearLine(uint16_t line) {
+    for (uint16_t column = 0; column < MAX_COLUMNS; column++) {
+        Cell * cell = &grid[line][column];
+        cell->ascii = ' ';
+        cell->fg = DEFAULT_TEXT_COLOR;
+        cell->bg = DEFAULT_BACKGROUND_COLOR;
+        cell->damaged = 0;
+    }
+    if (lineDamaged[line]) {
+        lineDamaged[line] = 0;
+        damagedLines--;
     }
 }
 
-// `ascii` ASCII character to print (0-127)
-void putChar(char ascii) {
-    dirty_line = 1;
+// Redraws only the cells that changed since the last pass
+static void renderDamage(void) {
+    for (uint16_t row = 0; row < rows && damagedLines > 0; row++) {
+        uint16_t line = lineIndex(row);
+        if (!lineDamaged[line]) {
+            continue;
+        }
+        for (uint16_t column = 0; column < columns; column++) {
+            Cell * cell = &grid[line][column];
+            if (cell->damaged) {
+                renderCell(cell, column, row);
+                cell->damaged = 0;
+            }
+        }
+        lineDamaged[line] = 0;
+        damagedLines--;
+    }
+}
+
+static inline void ensureGrid(void) {
+    if (rows == 0) {
+        resizeGrid(fontSize);
+    }
+}
+
+// The new line is painted by the video scroll, so it starts clean
+static void scrollGrid(void) {
+    gridTop = (gridTop + 1) % MAX_ROWS;
+    clearLine(lineIndex(rows - 1));
+    scrollVideoMemoryUp(cellHeight(), DEFAULT_BACKGROUND_COLOR);
+}
+
+/*
+ * Recomputes the grid size for `size` and re-renders everything from the cells.
+ * The cursor line stays visible; lines that appear at the bottom start blank and
+ * columns beyond the new width are kept in the grid, just not drawn.
+ */
+static void resizeGrid(uint8_t size) {
+    if (rows == 0) {
+        for (uint16_t line = 0; line < MAX_ROWS; line++) {
+            clearLine(line);
+        }
+    }
+    uint16_t previousRows = rows;
+    fontSize = size;
+    columns = getWindowWidth() / cellWidth();
+    rows = getWindowHeight() / cellHeight();
+    columns = columns > MAX_COLUMNS ? MAX_COLUMNS : columns;
+    rows = rows > MAX_ROWS ? MAX_ROWS : rows;
+
+    if (cursorRow >= rows) {
+        gridTop = (gridTop + cursorRow - rows + 1) % MAX_ROWS;
+        previousRows = rows;
+        cursorRow = rows - 1;
+    }
+    if (cursorColumn >= columns) {
+        cursorColumn = columns - 1;
+    }
+    for (uint16_t row = previousRows; row < rows; row++) {
+        clearLine(lineIndex(row));
+    }
+
+    fillVideoMemory(DEFAULT_BACKGROUND_COLOR);
+    for (uint16_t row = 0; row < rows; row++) {
+        uint16_t line = lineIndex(row);
+        for (uint16_t column = 0; column < columns; column++) {
+            if (!isBlank(&grid[line][column])) {
+                damageCell(line, &grid[line][column]);
+            }
+        }
+    }
+    renderDamage();
+}
+
+static void advanceLine(void) {
+    cursorColumn = 0;
+    if (cursorRow + 1 < rows) {
+        cursorRow++;
+    } else {
+        scrollGrid();
+    }
+}
+
+// Hides a cursor drawn at the current position. Writing a ' ' there instead would
+// wrap to the next line when the line is exactly full.
+static void clearCursorCell(void) {
+    if (cursorColumn >= columns) {
+        return;
+    }
+    uint16_t line = lineIndex(cursorRow);
+    Cell * cell = &grid[line][cursorColumn];
+    if (cell->ascii != ' ' || cell->bg != background_color) {
+        cell->ascii = ' ';
+        cell->fg = text_color;
+        cell->bg = background_color;
+        damageCell(line, cell);
+    }
+}
+
+// Updates the grid without rendering, so a whole write is drawn in a single pass
+static void writeChar(char ascii) {
     switch (ascii){
         case NEW_LINE_CHAR:
-            hideCursor();
-            newLine();
+            clearCursorCell();
+            advanceLine();
             break;
         case CARRIAGE_RETURN_CHAR:
-            hideCursor();
-            while (xBufferPosition > 0) {
-                retractPosition();
-            }
+            clearCursorCell();
+            cursorColumn = 0;
             break;
         case TABULATOR_CHAR:
             do {
-                putChar(' ');
-            } while(xBufferPosition % (TAB_SIZE * glyphSizeX * fontSize) != 0);
+                writeChar(' ');
+            } while(cursorColumn % TAB_SIZE != 0);
             break;
-        default:
-            if (xBufferPosition + glyphSizeX * fontSize > getWindowWidth()) {
-                newLine();
+        default: {
+            if (cursorColumn >= columns) {
+                advanceLine();
+            }
+            uint16_t line = lineIndex(cursorRow);
+            Cell * cell = &grid[line][cursorColumn];
+            if (cell->ascii != ascii || cell->fg != text_color || cell->bg != background_color) {
+                cell->ascii = ascii;
+                cell->fg = text_color;
+                cell->bg = background_color;
+                damageCell(line, cell);
+            }
+            cursorColumn++;
+            break;
+        }
+    }
+}
+
+static inline uint32_t defaultTextColor(void) {
+    return file_descriptor == FD_STDERR ? DEFAULT_ERROR_COLOR : DEFAULT_TEXT_COLOR;
+}
+
+// Blanks [fromColumn, toColumn) of a screen row with the current background
+static void eraseCells(uint16_t row, uint16_t fromColumn, uint16_t toColumn) {
+    uint16_t line = lineIndex(row);
+    for (uint16_t column = fromColumn; column < toColumn; column++) {
+        Cell * cell = &grid[line][column];
+        if (cell->ascii != ' ' || cell->bg != background_color) {
+            cell->ascii = ' ';
+            cell->fg = text_color;
+            cell->bg = background_color;
+            damageCell(line, cell);
+        }
+    }
+}
+
+static void selectGraphicRendition(void) {
+    if (ansiParamCount == 0) {
+        ansiParams[ansiParamCount++] = 0;
+    }
+    for (uint8_t i = 0; i < ansiParamCount; i++) {
+        uint16_t param = ansiParams[i];
+        if (param == 0) {
+            text_color = defaultTextColor();
+            background_color = DEFAULT_BACKGROUND_COLOR;
+        } else if (param >= 30 && param <= 37) {
+            text_color = ansiPalette[param - 30];
+        } else if (param >= 90 && param <= 97) {
+            text_color = ansiPalette[param - 90 + 8];
+        } else if (param >= 40 && param <= 47) {
+            background_color = ansiPalette[param - 40];
+        } else if (param >= 100 && param <= 107) {
+            background_color = ansiPalette[param - 100 + 8];
+        } else if (param == 39) {
+            text_color = defaultTextColor();
+        } else if (param == 49) {
+            background_color = DEFAULT_BACKGROUND_COLOR;
+        }
+        // Bold, underline, etc. are not supported by the font and are ignored
+    }
+}
+
+// Runs the CSI sequence ended by `command`; unknown sequences are dropped
+static void executeControlSequence(char command) {
+    uint16_t first = ansiParamCount > 0 ? ansiParams[0] : 0;
+    uint16_t count = first == 0 ? 1 : first;
+    switch (command) {
+        case 'm':
+            selectGraphicRendition();
+            break;
+        case 'A': // CUU
+            cursorRow = cursorRow > count ? cursorRow - count : 0;
+            break;
+        case 'B': // CUD
+            cursorRow = cursorRow + count < rows ? cursorRow + count : rows - 1;
+            break;
+        case 'C': // CUF
+            cursorColumn = cursorColumn + count < columns ? cursorColumn + count : columns - 1;
+            break;
+        case 'D': // CUB
+            cursorColumn = cursorColumn > count ? cursorColumn - count : 0;
+            break;
+        case 'H': // CUP: 1-based row;column
+        case 'f': {
+            uint16_t row = first == 0 ? 1 : first;
+            uint16_t column = ansiParamCount > 1 && ansiParams[1] != 0 ? ansiParams[1] : 1;
+            cursorRow = row <= rows ? row - 1 : rows - 1;
+            cursorColumn = column <= columns ? column - 1 : columns - 1;
+            break;
+        }
+        case 'K': // EL: 0 cursor to end, 1 start to cursor, 2 whole line
+            if (first == 0) {
+                eraseCells(cursorRow, cursorColumn, columns);
+            } else if (first == 1) {
+                eraseCells(cursorRow, 0, cursorColumn + 1 < columns ? cursorColumn + 1 : columns);
+            } else if (first == 2) {
+                eraseCells(cursorRow, 0, columns);
             }
+            break;
+        case 'J': // ED: 0 cursor to end, 1 start to cursor, 2 whole screen
+            if (first == 0) {
+                eraseCells(cursorRow, cursorColumn, columns);
+                for (uint16_t row = cursorRow + 1; row < rows; row++) {
+                    eraseCells(row, 0, columns);
+                }
+            } else if (first == 1) {
+                for (uint16_t row = 0; row < cursorRow; row++) {
+                    eraseCells(row, 0, columns);
+                }
+                eraseCells(cursorRow, 0, cursorColumn + 1 < columns ? cursorColumn + 1 : columns);
+            } else if (first == 2) {
+                for (uint16_t row = 0; row < rows; row++) {
+                    eraseCells(row, 0, columns);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
 
-            renderAscii(ascii, xBufferPosition, yBufferPosition);
-            xBufferPosition += glyphSizeX * fontSize;
+// Feeds one byte of console output through the escape sequence parser
+static void consumeChar(char ascii) {
+    switch (ansiState) {
+        case ANSI_NORMAL:
+            if (ascii == ESCAPE_CHAR) {
+                ansiState = ANSI_ESCAPE;
+            } else {
+                writeChar(ascii);
+            }
+            break;
+        case ANSI_ESCAPE:
+            if (ascii == '[') {
+                ansiState = ANSI_CSI;
+                ansiParamCount = 0;
+                ansiParams[0] = 0;
+            } else { // Not a CSI: the ESC is dropped and the byte printed as usual
+                ansiState = ANSI_NORMAL;
+                consumeChar(ascii);
+            }
+            break;
+        case ANSI_CSI:
+            if (ascii >= '0' && ascii <= '9') {
+                if (ansiParamCount == 0) {
+                    ansiParamCount = 1;
+                }
+                uint16_t * param = &ansiParams[ansiParamCount - 1];
+                *param = *param * 10 + (ascii - '0');
+            } else if (ascii == ';') {
+                if (ansiParamCount == 0) {
+                    ansiParamCount = 1; // "\e[;5H": the first parameter was omitted
+                }
+                if (ansiParamCount < ANSI_MAX_PARAMS) {
+                    ansiParams[ansiParamCount++] = 0;
+                }
+            } else if (ascii >= 0x40 && ascii <= 0x7E) { // Final byte
+                executeControlSequence(ascii);
+                ansiState = ANSI_NORMAL;
+            } else if (ascii < 0x20 || ascii > 0x3F) { // Malformed: abort the sequence
+                ansiState = ANSI_NORMAL;
+            }
             break;
     }
 }
 
+// `ascii` ASCII character to print (0-127)
+void putChar(char ascii) {
+    ensureGrid();
+    writeChar(ascii);
+    renderDamage();
+}
+
 int32_t printToFd(int32_t fd, const char * string, int32_t count) {
     if (fd == DEV_NULL) {
         return count;
@@ -174,10 +539,12 @@ int32_t printToFd(int32_t fd, const char * string, int32_t count) {
         }
     }
 
+    ensureGrid();
     int i = 0;
     for ( ; i < count; i++ ) {
-        putChar(string[i]);
+        consumeChar(string[i]);
     }
+    renderDamage();
 
     return i;
 }
@@ -189,11 +556,9 @@ void print(const char * string) {
 
 // Jumps to the next line, does not print an empty line
 void newLine(void) {
-    dirty_line = 0;
-    yBufferPosition += maxGlyphSizeYOnLine;
-    xBufferPosition = 0;
-    maxGlyphSizeYOnLine = fontSize * glyphSizeY;
-    scrollBufferPositionIfNeeded();
+    ensureGrid();
+    advanceLine();
+    renderDamage();
 }
 
 void printDec(uint64_t value) {
@@ -209,24 +574,27 @@ void printBin(uint64_t value) {
 }
 
 void clear(void) {
+    ensureGrid();
     fillVideoMemory(DEFAULT_BACKGROUND_COLOR);
-    xBufferPosition = 0;
-    yBufferPosition = 0;
+    for (uint16_t line = 0; line < MAX_ROWS; line++) {
+        clearLine(line);
+    }
+    gridTop = 0;
+    cursorColumn = 0;
+    cursorRow = 0;
 }
 
 void retractPosition() {
-    uint16_t window_width = getWindowWidth();
-    
-    if(xBufferPosition == 0){
-        yBufferPosition -= glyphSizeY * fontSize;
-        if (yBufferPosition < 0) {
-            yBufferPosition = 0;
+    ensureGrid();
+    if (cursorColumn == 0) {
+        if (cursorRow == 0) {
             return;
         }
-        xBufferPosition = window_width - (window_width % (fontSize * glyphSizeX));
+        cursorRow--;
+        cursorColumn = columns;
     }
 
-    xBufferPosition -= glyphSizeX * fontSize;
+    cursorColumn--;
 }
 
 void clearPreviousCharacter(void){
@@ -246,21 +614,18 @@ void hideCursor(void) {
 }
 
 uint8_t increaseFontSize(void) {
-    fontSize = fontSize > 9 ? fontSize : fontSize + 1;
-    maxGlyphSizeYOnLine =  dirty_line == 1 ? MAX(maxGlyphSizeYOnLine, glyphSizeY * fontSize) : (glyphSizeY * fontSize);
-    scrollBufferPositionIfNeeded();
-    return fontSize;
+    return setFontSize(fontSize + 1);
 }
 
 uint8_t decreaseFontSize(void) {
-    fontSize = fontSize <= 1 ? fontSize : fontSize - 1;
-    maxGlyphSizeYOnLine = dirty_line == 1 ? MAX(maxGlyphSizeYOnLine, glyphSizeY * fontSize) : (glyphSizeY * fontSize);
-    return fontSize;
+    return setFontSize(fontSize - 1);
 }
 
 uint8_t setFontSize(int8_t size) {
-    fontSize = (size < 1 ? 1 : size > 10 ? 10 : size);
-    maxGlyphSizeYOnLine = dirty_line == 1 ? MAX(maxGlyphSizeYOnLine, glyphSizeY * fontSize) : (glyphSizeY * fontSize);
+    size = (size < MIN_FONT_SIZE ? MIN_FONT_SIZE : size > MAX_FONT_SIZE ? MAX_FONT_SIZE : size);
+    if (size != fontSize || rows == 0) {
+        resizeGrid(size);
+    }
     return fontSize;
 }
 
@@ -5,6 +5,8 @@
 #include <interrupts.h>
 #include <syscallDispatcher.h>
 #include <keyboard.h>
+#include <video.h>
+#include <scheduler.h>
 
 const static char * register_names[] = {
 	"rax", "rbx", "rcx", "rdx", "rbp", "rdi", "rsi", "r8 ", "r9 ", "r10", "r11", "r12", "r13", "r14", "r15", "rsp", "rip", "rflags"
@@ -21,6 +23,7 @@ static void invalid_opcode(uint64_t * registers, int errorCode);
 void printExceptionData(uint64_t * registers, int errorCode);
 
 void exceptionDispatcher(int exception, uint64_t * registers) {
+	releaseFramebuffer(getpid()); // El dueño del framebuffer taparía el volcado
 	clear();
 	switch(exception) {
 		case ZERO_EXCEPTION_ID:
@@ -58,6 +61,7 @@ void printExceptionData(uint64_t * registers, int errorCode) {
 	setTextColor(0x00FFFFFF);
 
 	print("Press r to go back to Shell");
+	videoFlush(); // El timer queda enmascarado mientras se espera la tecla
 
 	char a;
 	// getKeyboardCharacter calls _hlt which triggers _sti
@@ -65,7 +69,7 @@ void printExceptionData(uint64_t * registers, int errorCode) {
 
 	picMasterMask(KEYBOARD_PIC_MASTER);
 	picSlaveMask(NO_INTERRUPTS);
-	while ((a = getKeyboardCharacter(0)) != 'r') {}
+	while ((a = getKeyboardCharacter(READ_FOCUSED)) != 'r') {}
 	picMasterMask(KEYBOARD_PIC_MASTER & TIMER_PIC_MASTER);
 	picSlaveMask(NO_INTERRUPTS);
 
@@ -12,7 +12,7 @@
 #include <processes.h>
 #include <syscall.h>
 #include <memory_manager.h>
-#include <pipe_manager.h>
+#include <file_descriptors.h>
 #include <scheduler.h>
 
 extern int64_t register_snapshot[18];
@@ -46,6 +46,11 @@ int64_t syscallDispatcher(Registers * registers) {
 		case 0x80000019: return sys_circle(registers->rdi, registers->rsi, registers->rdx, registers->rcx);
 		case 0x80000020: return sys_rectangle(registers->rdi, registers->rsi, registers->rdx, registers->rcx, registers->r8);
 		case 0x80000021: return sys_fill_video_memory(registers->rdi);
+		case 0x80000022: return sys_video_flush();
+		case 0x80000023: return sys_draw_batch((const DrawCommand *) registers->rdi, registers->rsi, (uint8_t) registers->rdx);
+		case 0x80000024: return sys_framebuffer_acquire((FramebufferInfo *) registers->rdi);
+		case 0x80000025: return sys_framebuffer_release();
+		case 0x80000026: return sys_blit((const Blit *) registers->rdi);
 
 		case 0x800000A0: return sys_exec((int (*)(void)) registers->rdi);
 
@@ -59,6 +64,10 @@ int64_t syscallDispatcher(Registers * registers) {
 		case 0x800000E0: return sys_get_register_snapshot((int64_t *) registers->rdi);
 
 		case 0x800000F0: return sys_get_character_without_display();
+		case 0x800000F1: return sys_set_console_mode((uint8_t) registers->rdi);
+		case 0x800000F2: return sys_key_events_open();
+		case 0x800000F3: return sys_key_events_read((KeyEvent *) registers->rdi, (uint32_t) registers->rsi);
+		case 0x800000F4: return sys_key_events_close();
 		
 		// ============================
 		// Process and sync syscalls
@@ -76,6 +85,9 @@ int64_t syscallDispatcher(Registers * registers) {
 		case 0x80000113: return my_sem_post((uint16_t) registers->rdi);
 		case 0x80000114: return my_sem_close((uint16_t) registers->rdi);
 		case 0x80000115: return my_sem_destroy((uint16_t) registers->rdi);
+		case 0x80000116: return my_futex_wait((volatile int32_t *) registers->rdi, (int32_t) registers->rsi);
+		case 0x80000117: return my_futex_wake((volatile int32_t *) registers->rdi, (uint32_t) registers->rsi);
+		case 0x80000118: return my_sem_open_named((const char *) registers->rdi, (uint64_t) registers->rsi);
 		
 		case 0x80000120: return my_yield();
 		case 0x80000121: return my_wait(registers->rdi);
@@ -83,7 +95,43 @@ int64_t syscallDispatcher(Registers * registers) {
 		case 0x80000131: return my_print_ps();
 		case 0x80000132: return (int64_t) my_malloc((uint64_t)registers->rdi);
 		case 0x80000133: return my_free((void *)registers->rdi);
-		case 0x80000140: return my_pipe_get();
+		case 0x80000140: return my_pipe((int16_t *) registers->rdi);
+		case 0x80000141: return my_dup((int16_t) registers->rdi);
+		case 0x80000142: return my_dup2((int16_t) registers->rdi, (int16_t) registers->rsi);
+		case 0x80000143: return my_close((int16_t) registers->rdi);
+
+		case 0x80000150: return my_mq_create((const char *) registers->rdi, (uint16_t) registers->rsi, (uint16_t) registers->rdx);
+		case 0x80000151: return my_mq_open((const char *) registers->rdi);
+		case 0x80000152: return my_mq_close((uint16_t) registers->rdi);
+		case 0x80000153: return my_mq_send((uint16_t) registers->rdi, (const void *) registers->rsi, (uint16_t) registers->rdx, (uint8_t) registers->rcx, (uint8_t) registers->r8);
+		case 0x80000154: return my_mq_receive((uint16_t) registers->rdi, (void *) registers->rsi, (uint16_t) registers->rdx, (uint8_t *) registers->rcx, (uint8_t) registers->r8);
+
+		case 0x80000160: return my_shm_create((uint32_t) registers->rdi, (uint64_t) registers->rsi);
+		case 0x80000161: return (int64_t) my_shm_attach((uint32_t) registers->rdi);
+		case 0x80000162: return my_shm_detach((void *) registers->rdi);
+		case 0x80000163: return my_shm_destroy((uint32_t) registers->rdi);
+
+		case 0x80000170: return my_mutex_create();
+		case 0x80000171: return my_mutex_lock((uint16_t) registers->rdi);
+		case 0x80000172: return my_mutex_unlock((uint16_t) registers->rdi);
+		case 0x80000173: return my_mutex_destroy((uint16_t) registers->rdi);
+
+		case 0x80000180: return my_cond_create();
+		case 0x80000181: return my_cond_wait((uint16_t) registers->rdi, (uint16_t) registers->rsi);
+		case 0x80000182: return my_cond_signal((uint16_t) registers->rdi);
+		case 0x80000183: return my_cond_broadcast((uint16_t) registers->rdi);
+		case 0x80000184: return my_cond_destroy((uint16_t) registers->rdi);
+
+		case 0x80000190: return my_rwlock_create();
+		case 0x80000191: return my_rwlock_read_lock((uint16_t) registers->rdi);
+		case 0x80000192: return my_rwlock_read_unlock((uint16_t) registers->rdi);
+		case 0x80000193: return my_rwlock_write_lock((uint16_t) registers->rdi);
+		case 0x80000194: return my_rwlock_write_unlock((uint16_t) registers->rdi);
+		case 0x80000195: return my_rwlock_destroy((uint16_t) registers->rdi);
+
+		case 0x800001A0: return (int64_t) my_local_storage();
+		case 0x800001A1: return my_set_exit_hook((void (*)(void)) registers->rdi);
+		case 0x800001A2: return my_isatty((int16_t) registers->rdi);
 		
 		default:
             return 0;
@@ -95,58 +143,19 @@ int64_t syscallDispatcher(Registers * registers) {
 // ==================================================================
 
 int32_t sys_write(int32_t fd, char * __user_buf, int32_t count) {
-	// Pipe-aware write:
-	// 1) If fd is a pipe id (>= BUILT_IN_DESCRIPTORS), write to that pipe
-	// 2) Else if fd == STDOUT but the current process has STDOUT redirected to a pipe, write to that pipe
-	// 3) Else write to screen/tty
+	// fd is an index into the current process' descriptor table: console, pipe or /dev/null
 	if (fd == DEV_NULL) {
 		return count;
 	}
-	if (fd >= BUILT_IN_DESCRIPTORS) {
-		return (int32_t) writePipe(getpid(), (uint16_t)fd, __user_buf, (uint64_t)count);
-	}
-	if (fd == STDOUT) {
-		int16_t mapped = getCurrentProcessFileDescriptor(STDOUT);
-		if (mapped == DEV_NULL) {
-			return count;
-		}
-		if (mapped >= BUILT_IN_DESCRIPTORS) {
-			return (int32_t) writePipe(getpid(), (uint16_t)mapped, __user_buf, (uint64_t)count);
-		}
-	}
-    return printToFd(fd, __user_buf, count);
+	return (int32_t) fdWrite(getCurrentProcess(), (int16_t) fd, __user_buf, (uint64_t) count);
 }
 
 int32_t sys_read(int32_t fd, signed char * __user_buf, int32_t count) {
-	// Pipe-aware read:
-	// 1) If fd is a pipe id (>= BUILT_IN_DESCRIPTORS), read from that pipe
-	// 2) Else if fd == STDIN but the current process has STDIN redirected to a pipe, read from that pipe
-	// 3) Else read from keyboard buffer
+	// fd is an index into the current process' descriptor table: keyboard, pipe or /dev/null
 	if (fd == DEV_NULL) {
 		return 0;
 	}
-	if (fd >= BUILT_IN_DESCRIPTORS) {
-		return (int32_t) readPipe((uint16_t)fd, (char *)__user_buf, (uint64_t)count);
-	}
-	if (fd == STDIN) {
-		int16_t mapped = getCurrentProcessFileDescriptor(STDIN);
-		if (mapped == DEV_NULL) {
-			return 0;
-		}
-		if (mapped >= BUILT_IN_DESCRIPTORS) {
-			return (int32_t) readPipe((uint16_t)mapped, (char *)__user_buf, (uint64_t)count);
-		}
-	}
-	int32_t i;
-	int c;
-	for(i = 0; i < count; i++){
-		c = getKeyboardCharacter(AWAIT_RETURN_KEY | SHOW_BUFFER_WHILE_TYPING);
-		if (c == EOF) {
-			break;
-		}
-		*(__user_buf + i) = (int8_t)c;
-	}
-    return i;
+	return (int32_t) fdRead(getCurrentProcess(), (int16_t) fd, (char *) __user_buf, (uint64_t) count);
 }
 
 // ==================================================================
@@ -242,6 +251,31 @@ int32_t sys_fill_video_memory(uint32_t hexColor) {
 	return 0;
 }
 
+int32_t sys_video_flush(void) {
+	videoFlush();
+	return 0;
+}
+
+int32_t sys_draw_batch(const DrawCommand * commands, uint64_t count, uint8_t flags) {
+	return drawCommands(commands, count, flags);
+}
+
+// Only the foreground job (the one holding the keyboard focus) may own the screen
+int32_t sys_framebuffer_acquire(FramebufferInfo * info) {
+	int32_t focused = getFocusedPid();
+	if (focused == -1 || !processesShareJob(getpid(), (uint16_t) focused))
+		return -1;
+	return acquireFramebuffer(getpid(), info);
+}
+
+int32_t sys_framebuffer_release(void) {
+	return releaseFramebuffer(getpid());
+}
+
+int32_t sys_blit(const Blit * blit) {
+	return blitImage(blit);
+}
+
 // ==================================================================
 // Custom exec system call
 // ==================================================================
@@ -258,6 +292,9 @@ int32_t sys_exec(int32_t (*fnPtr)(void)) {
 	int32_t aux = fnPtr();
 
 	restoreKeyFnMapNonKernel(map);
+	releaseFramebuffer(getpid());
+	releaseConsoleMode(getpid());
+	keyEventsClose(getpid());
 	setFontSize(fontSize);
 	setTextColor(text_color);
 	setBackgroundColor(background_color);
@@ -300,3 +337,23 @@ int32_t sys_get_register_snapshot(int64_t * registers) {
 int32_t sys_get_character_without_display(void) {
 	return getKeyboardCharacter(0);
 }
+
+int32_t sys_set_console_mode(uint8_t mode) {
+	return setConsoleMode(getpid(), (enum CONSOLE_MODES) mode);
+}
+
+// ==================================================================
+// Key event system calls
+// ==================================================================
+
+int32_t sys_key_events_open(void) {
+	return keyEventsOpen(getpid());
+}
+
+int64_t sys_key_events_read(KeyEvent * events, uint32_t max) {
+	return keyEventsRead(getpid(), events, max);
+}
+
+int32_t sys_key_events_close(void) {
+	return keyEventsClose(getpid());
+}
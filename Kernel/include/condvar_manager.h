@@ -0,0 +1,19 @@
+#ifndef _CONDVAR_MANAGER_H
+#define _CONDVAR_MANAGER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MAX_CONDVARS 128
+
+typedef struct CondVarManagerCDT *CondVarManagerADT;
+
+CondVarManagerADT createCondVarManager();
+int16_t condCreate();
+// Suelta el mutex (que debe tener tomado el proceso), espera una señal y lo vuelve a tomar
+int8_t condWait(uint16_t id, uint16_t mutexId);
+int8_t condSignal(uint16_t id);
+int8_t condBroadcast(uint16_t id);
+int8_t condDestroy(uint16_t id);
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <time.h>
 
+uint8_t cursorNeedsToggle(void);
 void toggleCursor(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef _DEFERRED_WORK_H
+#define _DEFERRED_WORK_H
+
+#include <stdint.h>
+
+#define DEFERRED_WORK_SLOTS 128
+
+// Trabajo diferido (bottom halves): los handlers de interrupción solo capturan el
+// estado y encolan acá lo caro (dibujar, llamar handlers de teclas). Lo ejecuta un
+// proceso del kernel, así la interrupción termina enseguida y el scheduler no se demora.
+typedef void (*DeferredFunction)(uint64_t arg);
+
+typedef struct DeferredWorkCDT *DeferredWorkADT;
+
+DeferredWorkADT createDeferredWork();
+// Pensada para llamarse desde un ISR. Devuelve -1 si la cola está llena
+int8_t deferWork(DeferredFunction fn, uint64_t arg);
+// Crea el proceso que drena la cola
+int16_t startDeferredWorker();
+
+#endif
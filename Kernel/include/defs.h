@@ -22,9 +22,27 @@
 /* Direcciones del Memory Manager */
 
 #define SYSTEM_VARIABLES 0x5A00
+#define CPU_SPEED_MHZ_ADDRESS 0x5010	  // Pure64: velocidad del CPU en MHz (16 bits)
 #define MEMORY_MANAGER_ADDRESS 0x50000	  // MemoryManagerCDT
 #define SCHEDULER_ADDRESS 0x60000		  // SchedulerCDT
 #define SEMAPHORE_MANAGER_ADDRESS 0x70000 // SemaphoreCDT
 #define PIPE_MANAGER_ADDRESS 0x80000	  // PipeManagerCDT
+#define MESSAGE_QUEUE_MANAGER_ADDRESS 0x90000 // MessageQueueManagerCDT
+#define SHARED_MEMORY_MANAGER_ADDRESS 0x91000 // ShmManagerCDT
+#define FUTEX_MANAGER_ADDRESS 0x92000	  // FutexManagerCDT
+#define MUTEX_MANAGER_ADDRESS 0x93000	  // MutexManagerCDT
+#define CONDVAR_MANAGER_ADDRESS 0x94000	  // CondVarManagerCDT
+#define RWLOCK_MANAGER_ADDRESS 0x95000	  // RWLockManagerCDT
+#define PROCESS_LOCAL_STORAGE_ADDRESS 0x96000 // Almacenamiento local del proceso en ejecución (puntero)
+#define DEFERRED_WORK_ADDRESS 0x97000	  // DeferredWorkCDT
+
+/* Back buffer de video: fuera del heap y de los módulos */
+#define BACK_BUFFER_ADDRESS 0x1000000
+#define BACK_BUFFER_MAX_SIZE (8 << 20)
+
+/* Celdas de la consola y filas expandidas de los glifos, junto al back buffer */
+#define CONSOLE_GRID_ADDRESS (BACK_BUFFER_ADDRESS + BACK_BUFFER_MAX_SIZE)
+#define CONSOLE_GRID_MAX_SIZE (1 << 19)
+#define GLYPH_CACHE_ADDRESS (CONSOLE_GRID_ADDRESS + CONSOLE_GRID_MAX_SIZE)
 
 #endif
\ No newline at end of file
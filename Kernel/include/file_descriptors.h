@@ -0,0 +1,43 @@
+#ifndef _FILE_DESCRIPTORS_H
+#define _FILE_DESCRIPTORS_H
+
+#include <stdint.h>
+#include <processes.h>
+
+#define FD_INITIAL_CAPACITY 8
+#define FD_MAX_CAPACITY 256
+
+typedef enum {
+    CONSOLE_IN = 0,
+    CONSOLE_OUT,
+    CONSOLE_ERR,
+    PIPE_READ,
+    PIPE_WRITE,
+    NULL_DEVICE
+} FileType;
+
+// Archivo abierto compartido por todos los descriptores que lo referencian (dup, hijos)
+typedef struct OpenFile {
+    FileType type;
+    uint16_t pipeId;
+    uint16_t references;
+} OpenFile;
+
+// Arma la tabla del hijo: sus descriptores 0..2 son copias de los descriptores
+// fileDescriptors[] del padre (DEV_NULL para descartar). Sin padre, o con
+// fileDescriptors NULL, usa la consola. El resto de la tabla del padre no se hereda.
+int8_t fdTableInit(Process *p, Process *parent, const int16_t fileDescriptors[3]);
+// Cierra todos los descriptores y libera la tabla
+void fdTableFree(Process *p);
+
+OpenFile *fdGet(const Process *p, int16_t fd);
+int8_t fdIsType(const Process *p, int16_t fd, FileType type);
+int8_t fdPipe(Process *p, int16_t fds[2]);
+int16_t fdDup(Process *p, int16_t fd);
+int16_t fdDup2(Process *p, int16_t fd, int16_t newFd);
+int8_t fdClose(Process *p, int16_t fd);
+
+int64_t fdRead(Process *p, int16_t fd, char *buffer, uint64_t len);
+int64_t fdWrite(Process *p, int16_t fd, const char *buffer, uint64_t len);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef _FUTEX_H
+#define _FUTEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FUTEX_BUCKETS 64
+
+typedef struct FutexManagerCDT *FutexManagerADT;
+
+FutexManagerADT createFutexManager();
+// Bloquea al proceso actual solo si *address sigue valiendo expected. Devuelve -1 si no durmió
+int8_t futexWait(volatile int32_t *address, int32_t expected);
+// Despierta hasta count procesos dormidos en address. Devuelve cuántos despertó
+int32_t futexWake(volatile int32_t *address, uint32_t count);
+
+#endif
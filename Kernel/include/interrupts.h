@@ -21,6 +21,11 @@ void _sti(void);
 
 void _hlt(void);
 
+// Guarda RFLAGS y deshabilita interrupciones; _restoreFlags las deja como estaban
+uint64_t _cliSave(void);
+
+void _restoreFlags(uint64_t flags);
+
 void picMasterMask(uint8_t mask);
 
 void picSlaveMask(uint8_t mask);
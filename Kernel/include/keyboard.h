@@ -98,16 +98,56 @@ typedef void (*SpecialKeyHandler)(enum KEYS scancode);
 enum KEYBOARD_OPTIONS {
     SHOW_BUFFER_WHILE_TYPING = 0b00000001,
     AWAIT_RETURN_KEY = 0b00000010,
-    MODIFY_BUFFER = 0b00000100
+    MODIFY_BUFFER = 0b00000100,
+    READ_FOCUSED = 0b00001000 // read the focused consumer's queue instead of the caller's
 };
 
+#define INPUT_CONSUMERS 16
+
+// Input focus: the process on top of the focus stack receives the keystrokes
+int8_t inputFocusPush(int32_t owner);
+void inputFocusRemove(int32_t owner);
+int32_t getFocusedPid(void);
+
+enum CONSOLE_MODES {
+    CONSOLE_CANONICAL = 0, // line editing with echo, reads return whole lines
+    CONSOLE_RAW = 1        // no echo, reads return keys as they come
+};
+
+// Key events: every make and break code is timestamped and copied into the ring of each
+// process that subscribed, so a game loop can poll all of them once per frame instead of
+// running callbacks inside the keyboard interrupt
+#define KEY_EVENT_CONSUMERS 8
+#define KEY_EVENT_RING_SIZE 128
+
+#define KEY_MOD_SHIFT     0x01
+#define KEY_MOD_CONTROL   0x02
+#define KEY_MOD_CAPS_LOCK 0x04
+
+typedef struct KeyEvent {
+    uint64_t ticks;     // timer ticks since boot
+    uint8_t scancode;   // make code (enum KEYS)
+    uint8_t pressed;    // 1 key down, 0 key up
+    uint8_t modifiers;  // KEY_MOD_* held when the event happened
+    int8_t ascii;       // translated character, 0 if the key has none
+} KeyEvent;
+
+int8_t keyEventsOpen(int32_t owner);
+// Copies up to max pending events without blocking and returns how many, -1 if not subscribed
+int64_t keyEventsRead(int32_t owner, KeyEvent * events, uint32_t max);
+int8_t keyEventsClose(int32_t owner);
+
 int8_t getKeyboardCharacter(enum KEYBOARD_OPTIONS keyboard_options);
+int64_t readConsole(char * destination, uint64_t len);
+int8_t setConsoleMode(int32_t owner, enum CONSOLE_MODES mode);
+void releaseConsoleMode(int32_t owner);
 void addCharToBuffer(int8_t ascii, uint8_t showOutput);
 uint16_t clearBuffer();
 uint8_t keyboardHandler();
 
 // All special keys *EXCEPT* for TAB and RETURN can be registered
 // Printable keys, including tab (`\t`) and return (`\n`) can be obtained via `getKeyboardCharacter` (`getchar`/`sys_read`)
+// A handler registered by a process runs in that process the next time it waits for console input
 uint8_t registerSpecialKey(enum KEYS scancode, SpecialKeyHandler fn, uint8_t registeredFromKernel);
 void clearKeyFnMapNonKernel(SpecialKeyHandler * map);
 void restoreKeyFnMapNonKernel(SpecialKeyHandler * map);
@@ -8,6 +8,7 @@
 #define EOF -1
 
 size_t strlen(const char * s);
+int strcmp(const char * s1, const char * s2);
 void * memset(void * destination, int32_t character, uint64_t length);
 void * memcpy(void * destination, const void * source, uint64_t length);
 void printf(const char * string);
@@ -20,4 +21,12 @@ uint8_t getMinute(void);
 uint8_t getHour(void);
 
 void forceTimerTick(void);
+
+uint32_t _cpuidEdx(uint32_t leaf);
+uint64_t _rdmsr(uint32_t msr);
+void _wrmsr(uint32_t msr, uint64_t value);
+uint64_t _rdtsc(void);
+uint64_t _readCR3(void);
+void _invlpg(uint64_t address);
+void _wbinvd(void);
 #endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef _MQUEUE_MANAGER_H
+#define _MQUEUE_MANAGER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MQ_MAX_QUEUES 64
+#define MQ_NAME_MAX 32
+#define MQ_PRIORITIES 8			   // 0 (menor) .. MQ_PRIORITIES - 1 (mayor)
+#define MQ_MAX_MESSAGES 256
+#define MQ_MAX_MESSAGE_SIZE 1024
+
+// Flags de mqSend / mqReceive
+#define MQ_NONBLOCK 0x01
+
+typedef struct MessageQueueManagerCDT *MessageQueueManagerADT;
+
+MessageQueueManagerADT createMessageQueueManager();
+
+// Crea una cola con capacidad fija; name puede ser NULL para una cola anónima
+int16_t mqCreate(const char *name, uint16_t maxMessages, uint16_t messageSize);
+// Abre una cola existente por nombre y devuelve su id
+int16_t mqOpen(const char *name);
+// Suelta una referencia del proceso actual; la cola se destruye al cerrar la última
+int8_t mqClose(uint16_t id);
+// Suelta todas las referencias de un proceso (al morir)
+void mqCloseAllForPid(uint16_t pid);
+int64_t mqSend(uint16_t id, const void *message, uint16_t length, uint8_t priority, uint8_t flags);
+int64_t mqReceive(uint16_t id, void *buffer, uint16_t length, uint8_t *priority, uint8_t flags);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef _MUTEX_MANAGER_H
+#define _MUTEX_MANAGER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MAX_MUTEXES 128
+#define NO_OWNER (-1)
+
+typedef struct MutexManagerCDT *MutexManagerADT;
+
+MutexManagerADT createMutexManager();
+int16_t mutexCreate();
+// Bloquea hasta obtener el mutex. Mientras espera, el dueño hereda la prioridad del que espera
+int8_t mutexLock(uint16_t id);
+// Solo el dueño puede liberarlo; se le devuelve su prioridad original
+int8_t mutexUnlock(uint16_t id);
+// Como mutexUnlock pero sin ceder la CPU (para las variables de condición)
+int8_t mutexRelease(uint16_t id);
+int8_t mutexDestroy(uint16_t id);
+// Libera los mutex que tenga tomados un proceso (al morir)
+void mutexReleaseAllForPid(uint16_t pid);
+
+#endif
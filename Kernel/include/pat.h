@@ -0,0 +1,10 @@
+#ifndef _PAT_H
+#define _PAT_H
+
+#include <stdint.h>
+
+// Marca [base, base + size) como write-combining usando la PAT.
+// Devuelve -1 si el CPU no tiene PAT o si el rango no está mapeado.
+int8_t setWriteCombining(uint64_t base, uint64_t size);
+
+#endif
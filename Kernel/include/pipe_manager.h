@@ -10,12 +10,16 @@
 
 typedef struct PipeManagerCDT *PipeManagerADT;
 PipeManagerADT createPipeManager();
-int16_t getLastFreePipe();
-int8_t pipeOpen(uint16_t id, uint8_t mode);
-int8_t pipeOpenForPid(uint16_t pid, uint16_t id, uint8_t mode);
-int8_t pipeClose(uint16_t id);
-int8_t pipeCloseForPid(uint16_t pid, uint16_t id);
+// Crea un pipe sin extremos abiertos y devuelve su id
+int16_t pipeCreate();
+// Cada extremo abierto (un OpenFile) suma una referencia de lectura o escritura
+int8_t pipeAttach(uint16_t id, uint8_t mode);
+// Sin escritores, los lectores leen EOF; el pipe se libera cuando no queda ningún extremo
+int8_t pipeDetach(uint16_t id, uint8_t mode);
+// Libera un pipe al que nunca se le abrió un extremo; falla si tiene alguno
+int8_t pipeDestroy(uint16_t id);
+// Devuelve 0 (EOF) si el pipe está vacío y no quedan escritores
 int64_t readPipe(uint16_t id, char *destinationBuffer, uint64_t len);
-int64_t writePipe(uint16_t pid, uint16_t id, char *sourceBuffer, uint64_t len);
+int64_t writePipe(uint16_t id, char *sourceBuffer, uint64_t len);
 
-#endif
\ No newline at end of file
+#endif
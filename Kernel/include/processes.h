@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <linkedListADT.h>
 
 #define STACK_SIZE (1 << 13)
 #define MAX_PRIORITY 4
@@ -11,6 +12,7 @@
 #define STDERR 2
 #define DEV_NULL (-1)
 #define BUILT_IN_DESCRIPTORS 3
+#define PROCESS_LOCAL_STORAGE_SIZE 2048
 
 typedef int (*MainFunction)(int, char**);
 
@@ -35,7 +37,17 @@ typedef struct Process {
     uint16_t waitingForPid;
     int32_t retValue;
     uint8_t unkillable;
-    int16_t fileDescriptors[3];
+    struct OpenFile **fdTable; // indexada por descriptor, NULL si está libre
+    uint16_t fdCapacity;
+    Node waitNode;            // entrada intrusiva en una cola de espera
+    void *waitQueue;          // WaitQueueADT en la que está bloqueado, NULL si ninguna
+    const void *waitChannel;  // dirección por la que espera (futex), opcional
+    int8_t inheritedPriority; // prioridad heredada por un mutex, -1 si no hereda
+    uint8_t basePriority;     // prioridad a restaurar cuando deja de heredar
+    void *localStorage;       // memoria propia del proceso para userland (stdio), NULL hasta que la pide
+    void (*exitHook)(void);   // se llama al retornar de la función principal, NULL si no hay
+    struct Job *job;          // trabajo al que pertenece (lo que mata Ctrl+C), NULL si ninguno
+    Node *jobNode;            // su entrada en la lista del trabajo
 } Process;
 
 typedef struct ProcessSnapshot {
@@ -60,8 +72,9 @@ extern void * _initialize_stack_frame(void (*entry)(void*, void*),
 // Minimal kernel-level helpers referenced by processes.c
 int killCurrentProcess(int32_t retValue);
 
-// Inicializa un proceso con todos sus componentes
-void initProcess(Process *p,
+// Inicializa un proceso con todos sus componentes. Devuelve -1, sin dejar nada
+// reservado, si falta memoria
+int8_t initProcess(Process *p,
                  uint16_t pid, uint16_t parentPid,
                  MainFunction code, char **args, const char *name,
                  uint8_t priority, const int16_t fileDescriptors[3],
@@ -70,8 +83,8 @@ void initProcess(Process *p,
 // Wrapper de entrada para todos los procesos
 void processWrapper(void *fn, void *argv_ptr);
 
-// Cierra todos los file descriptors de un proceso
-void closeFileDescriptors(Process *p);
+// Suelta todo lo que el proceso tenga tomado (file descriptors, memoria compartida, semáforos con nombre, mutex, rwlocks)
+void releaseProcessResources(Process *p);
 
 // Libera completamente un proceso y todos sus recursos
 void freeProcess(Process *p);
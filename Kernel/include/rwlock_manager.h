@@ -0,0 +1,22 @@
+#ifndef _RWLOCK_MANAGER_H
+#define _RWLOCK_MANAGER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MAX_RWLOCKS 64
+
+typedef struct RWLockManagerCDT *RWLockManagerADT;
+
+RWLockManagerADT createRWLockManager();
+int16_t rwlockCreate();
+// Varios lectores a la vez; un escritor esperando frena a los lectores nuevos
+int8_t rwlockReadLock(uint16_t id);
+int8_t rwlockReadUnlock(uint16_t id);
+int8_t rwlockWriteLock(uint16_t id);
+int8_t rwlockWriteUnlock(uint16_t id);
+int8_t rwlockDestroy(uint16_t id);
+// Suelta los locks de lectura y escritura que tenga un proceso (al morir)
+void rwlockReleaseAllForPid(uint16_t pid);
+
+#endif
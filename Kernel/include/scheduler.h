@@ -20,14 +20,22 @@ void *sched_tick_isr(void *prevStackPointer);
 int32_t killProcess(uint16_t pid, int32_t retValue);
 int32_t killCurrentProcess(int32_t retValue);
 uint16_t getpid();
+Process *getCurrentProcess();
+Process *getProcess(uint16_t pid);
 ProcessState getProcessStatus(uint16_t pid);
 ProcessSnapshotList *getProcessSnapshot();
 int32_t setPriority(uint16_t pid, uint8_t newPriority);
+// Herencia de prioridad para los mutex
+int32_t inheritPriority(uint16_t pid, uint8_t priority);
+int32_t restorePriority(uint16_t pid, int8_t inherited);
 int8_t setStatus(uint16_t pid, uint8_t newStatus);
 int32_t processIsAlive(uint16_t pid);
 void yield();
-int8_t changeFD(uint16_t pid, uint8_t position, int16_t newFd);
-int16_t getCurrentProcessFileDescriptor(uint8_t fdIndex);
-void killForegroundProcess();
+// Trabajos (grupos de procesos de un mismo comando). jobJoin devuelve -1 si falta memoria
+int8_t jobJoin(Process *process, uint8_t newJob);
+void jobLeave(Process *process);
+int8_t processesShareJob(uint16_t pid, uint16_t other);
+// Ctrl+C: mata al trabajo del proceso con el foco del teclado, y solo a ese
+void killForegroundProcess(int32_t pid);
 int32_t killProcessNoZombie(uint16_t pid, int32_t retValue);
 #endif
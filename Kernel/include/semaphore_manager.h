@@ -3,6 +3,12 @@
 
 #include <stdint.h>
 #include <stddef.h>
+
+#define SEM_NAME_MAX 32
+// Los ids numéricos los elige el usuario; los de semáforos con nombre los asigna el kernel
+#define FIRST_NAMED_SEM_ID 0x8000
+#define MAX_SEMAPHORE_ID 0xFFFF
+
 typedef struct SemaphoreManagerCDT *SemaphoreManagerADT;
 
 SemaphoreManagerADT createSemaphoreManager();
@@ -12,8 +18,10 @@ int8_t semClose(uint16_t id);
 int8_t semPost(uint16_t id);
 int8_t semWait(uint16_t id);
 int8_t semDestroy(uint16_t id);
-
-// low-level atomic xchg used by semaphore mutex
-uint64_t _xchg(volatile uint64_t *addr, uint64_t newValue);
+// Abre o crea un semáforo por nombre y devuelve su id. Cuenta una referencia del
+// proceso actual; se destruye al cerrar la última o cuando mueren quienes lo abrieron
+int32_t semOpenNamed(const char *name, uint32_t initialValue);
+// Suelta todas las referencias a semáforos con nombre de un proceso (al morir)
+void semCloseAllForPid(uint16_t pid);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef _SHM_MANAGER_H
+#define _SHM_MANAGER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SHM_MAX_SEGMENTS 64
+#define SHM_PAGE_SIZE 0x1000
+#define SHM_MAX_SIZE (1 << 20)
+
+typedef struct ShmManagerCDT *ShmManagerADT;
+
+ShmManagerADT createShmManager();
+// Crea un segmento identificado por key. Falla si la key ya existe
+int8_t shmCreate(uint32_t key, uint64_t size);
+// Devuelve la dirección (alineada a página) del segmento y suma una referencia del proceso actual
+void *shmAttach(uint32_t key);
+// Quita una referencia del proceso actual; el segmento se libera al soltar la última
+int8_t shmDetach(void *address);
+// Oculta la key; el segmento se libera cuando no quedan procesos adjuntos
+int8_t shmDestroy(uint32_t key);
+// Suelta todas las referencias de un proceso (al morir)
+void shmDetachAll(uint16_t pid);
+
+#endif
@@ -13,6 +13,9 @@ int64_t my_sem_wait(uint16_t sem_id);
 int64_t my_sem_post(uint16_t sem_id);
 int64_t my_sem_close(uint16_t sem_id);
 int64_t my_sem_destroy(uint16_t sem_id);
+int64_t my_sem_open_named(const char *name, uint64_t initialValue);
+int64_t my_futex_wait(volatile int32_t *address, int32_t expected);
+int64_t my_futex_wake(volatile int32_t *address, uint32_t count);
 int64_t my_yield();
 int64_t my_wait(int64_t pid);
 // Extra utilities for userland
@@ -20,4 +23,37 @@ int64_t my_mm_state(MMState *state);
 int64_t my_print_ps(void);
 void *my_malloc(uint64_t size);
 int64_t my_free(void *ptr);
-int64_t my_pipe_get(void);
\ No newline at end of file
+int64_t my_pipe(int16_t fds[2]);
+int64_t my_dup(int16_t fd);
+int64_t my_dup2(int16_t fd, int16_t newFd);
+int64_t my_close(int16_t fd);
+// Shared memory
+int64_t my_shm_create(uint32_t key, uint64_t size);
+void *my_shm_attach(uint32_t key);
+int64_t my_shm_detach(void *address);
+int64_t my_shm_destroy(uint32_t key);
+int64_t my_mutex_create();
+int64_t my_mutex_lock(uint16_t id);
+int64_t my_mutex_unlock(uint16_t id);
+int64_t my_mutex_destroy(uint16_t id);
+int64_t my_cond_create();
+int64_t my_cond_wait(uint16_t id, uint16_t mutexId);
+int64_t my_cond_signal(uint16_t id);
+int64_t my_cond_broadcast(uint16_t id);
+int64_t my_cond_destroy(uint16_t id);
+int64_t my_rwlock_create();
+int64_t my_rwlock_read_lock(uint16_t id);
+int64_t my_rwlock_read_unlock(uint16_t id);
+int64_t my_rwlock_write_lock(uint16_t id);
+int64_t my_rwlock_write_unlock(uint16_t id);
+int64_t my_rwlock_destroy(uint16_t id);
+// Message queues
+int64_t my_mq_create(const char *name, uint16_t maxMessages, uint16_t messageSize);
+int64_t my_mq_open(const char *name);
+int64_t my_mq_close(uint16_t id);
+int64_t my_mq_send(uint16_t id, const void *message, uint16_t length, uint8_t priority, uint8_t flags);
+int64_t my_mq_receive(uint16_t id, void *buffer, uint16_t length, uint8_t *priority, uint8_t flags);
+// Process local storage
+void *my_local_storage();
+int64_t my_set_exit_hook(void (*hook)(void));
+int64_t my_isatty(int16_t fd);
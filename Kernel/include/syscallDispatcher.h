@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <keyboard.h>
+#include <video.h>
 
 typedef struct {
     int64_t r15;
@@ -52,6 +53,14 @@ int32_t sys_circle(uint32_t hexColor, uint64_t topLeftX, uint64_t topLeftY, uint
 // Draw rectangle syscall prototype
 int32_t sys_rectangle(uint32_t color, uint64_t width_pixels, uint64_t height_pixels, uint64_t initial_pos_x, uint64_t initial_pos_y);
 int32_t sys_fill_video_memory(uint32_t hexColor);
+int32_t sys_video_flush(void);
+// Executes a whole list of draw commands in a single syscall
+int32_t sys_draw_batch(const DrawCommand * commands, uint64_t count, uint8_t flags);
+// Direct framebuffer access for the foreground process
+int32_t sys_framebuffer_acquire(FramebufferInfo * info);
+int32_t sys_framebuffer_release(void);
+// Copies a user image to the screen (clipping, color key, integer scale)
+int32_t sys_blit(const Blit * blit);
 
 // Custom exec syscall prototype
 int32_t sys_exec(int32_t (*fnPtr)(void));
@@ -67,5 +76,11 @@ int32_t sys_get_register_snapshot(int64_t * registers);
 
 // Get character without showing
 int32_t sys_get_character_without_display(void);
+int32_t sys_set_console_mode(uint8_t mode);
+
+// Key events
+int32_t sys_key_events_open(void);
+int64_t sys_key_events_read(KeyEvent * events, uint32_t max);
+int32_t sys_key_events_close(void);
 
 #endif
\ No newline at end of file
@@ -3,14 +3,97 @@
 
 #include <stdint.h>
 
+#define MAX_DRAW_COMMANDS 4096
+
+// Flags de drawCommands
+#define DRAW_FLUSH 0x01 // copia el back buffer a la pantalla al terminar la lista
+
+typedef enum {
+	DRAW_RECTANGLE = 0,
+	DRAW_CIRCLE,
+	DRAW_FILL,
+	DRAW_BITMAP,
+	DRAW_CIRCLE_OUTLINE,
+	DRAW_ROUNDED_RECTANGLE,
+	DRAW_COMMAND_TYPES
+} DrawCommandType;
+
+// Misma estructura que DrawCommand en Userland/include/libsys/sys.h
+typedef struct DrawCommand {
+	uint8_t type;
+	uint32_t color;
+	uint16_t x, y;			 // esquina superior izquierda
+	uint16_t width, height;	 // DRAW_CIRCLE usa width como diámetro
+	const uint32_t * pixels; // DRAW_BITMAP: width * height pixeles 0x00RRGGBB
+	uint16_t radius;		 // DRAW_ROUNDED_RECTANGLE: radio de las esquinas
+	uint16_t thickness;		 // DRAW_CIRCLE_OUTLINE: grosor del borde
+} DrawCommand;
+
+// Flags de Blit
+#define BLIT_COLOR_KEY 0x01 // los pixeles iguales a colorKey no se copian
+
+// Misma estructura que Blit en Userland/include/libsys/sys.h
+typedef struct Blit {
+	const void * pixels; // imagen de origen, B G R (24bpp) o B G R X (32bpp) por pixel
+	uint32_t stride;	 // bytes entre filas del origen
+	uint16_t width;		 // tamaño del origen en pixeles
+	uint16_t height;
+	uint8_t bpp;		 // 24 o 32
+	uint8_t flags;
+	uint8_t scale;		 // factor entero (>= 1)
+	uint32_t colorKey;	 // 0x00RRGGBB transparente si flags & BLIT_COLOR_KEY
+	int32_t x, y;		 // destino; puede quedar parcialmente fuera de pantalla
+} Blit;
+
+// Misma estructura que FramebufferInfo en Userland/include/libsys/sys.h
+typedef struct FramebufferInfo {
+	uint8_t * address; // framebuffer lineal, visible en pantalla
+	uint16_t pitch;	   // bytes por fila
+	uint16_t width;
+	uint16_t height;
+	uint8_t bpp;
+} FramebufferInfo;
+
+// Activa el back buffer; hasta entonces se dibuja directo al framebuffer
+void initVideo(void);
+// Copia al framebuffer las partes del back buffer que cambiaron
+void videoFlush(void);
+// Lo mismo, copiando a lo sumo maxRows filas. Devuelve 1 si quedaron filas por copiar
+uint8_t videoFlushRows(uint16_t maxRows);
+// Si quedan cambios del back buffer sin copiar al framebuffer
+uint8_t videoIsDirty(void);
+
 void putPixel(uint32_t hexColor, uint64_t x, uint64_t y);
+// Copia `width` pixeles ya convertidos al formato del framebuffer a partir de (x, y)
+void drawRow(const uint8_t * pixels, uint64_t x, uint64_t y, uint64_t width);
+// Convierte una máscara de 1bpp (bit i, LSB primero) a `count` pixeles en el formato del framebuffer
+void expandMask(uint8_t * dst, const uint8_t * mask, uint64_t count, uint32_t fg, uint32_t bg);
 void drawCircle(uint32_t hexColor, uint64_t topLeftX, uint64_t topLeftY, uint64_t diameter);
 void drawRectangle(uint32_t hexColor, uint64_t width, uint64_t height, uint64_t initial_pos_x, uint64_t initial_pos_y);
+void drawCircleOutline(uint32_t hexColor, uint64_t topLeftX, uint64_t topLeftY, uint64_t diameter, uint64_t thickness);
+void drawRoundedRectangle(uint32_t hexColor, uint64_t width, uint64_t height, uint64_t x, uint64_t y, uint64_t radius);
 void fillVideoMemory(uint32_t hexColor);
+void drawBitmap(const uint32_t * pixels, uint64_t x, uint64_t y, uint64_t width, uint64_t height);
+// Copia una imagen al back buffer con recorte, color transparente y escala; -1 si es inválida
+int8_t blitImage(const Blit * blit);
+// Valida toda la lista y recién después la dibuja; devuelve cuántos comandos ejecutó o -1
+int64_t drawCommands(const DrawCommand * commands, uint64_t count, uint8_t flags);
 
 uint16_t getWindowWidth(void);
 uint16_t getWindowHeight(void);
+uint8_t getBytesPerPixel(void);
 
 void scrollVideoMemoryUp(uint16_t scroll, uint32_t fillColor);
 
+// Mapea el framebuffer como write-combining (PAT); -1 si no se pudo
+int8_t videoEnableWriteCombining(void);
+// Benchmark de arranque: ancho de banda de llenar la pantalla, en MB/s
+uint64_t videoFillBandwidth(uint32_t hexColor);
+
+// Acceso directo y exclusivo al framebuffer: un solo dueño a la vez (-1 si ya tiene
+// otro) y, mientras tanto, el back buffer no se copia a la pantalla
+int8_t acquireFramebuffer(int32_t owner, FramebufferInfo * info);
+// Devuelve el framebuffer y redibuja la pantalla desde el back buffer
+int8_t releaseFramebuffer(int32_t owner);
+
 #endif
\ No newline at end of file
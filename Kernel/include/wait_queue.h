@@ -0,0 +1,29 @@
+#ifndef _WAIT_QUEUE_H
+#define _WAIT_QUEUE_H
+
+#include <stdint.h>
+#include <linkedListADT.h>
+#include <processes.h>
+
+// Colas de espera intrusivas: encadenan el waitNode del PCB, así que bloquear
+// y despertar nunca piden memoria. Un proceso espera en a lo sumo una cola.
+typedef LinkedListADT WaitQueueADT;
+
+WaitQueueADT createWaitQueue();
+// Despierta a todos los procesos que esperan y libera la cola
+void freeWaitQueue(WaitQueueADT queue);
+// Bloquea al proceso actual en la cola hasta que lo despierten
+void waitQueueSleep(WaitQueueADT queue);
+// Igual que waitQueueSleep, pero registra la dirección por la que se espera
+void waitQueueSleepOn(WaitQueueADT queue, const void *channel);
+// Despierta al primero de la cola. Devuelve su pid, o -1 si la cola estaba vacía
+int16_t waitQueueWakeOne(WaitQueueADT queue);
+// Despierta al primero que espera por channel
+int16_t waitQueueWakeChannel(WaitQueueADT queue, const void *channel);
+uint16_t waitQueueWakeAll(WaitQueueADT queue);
+// Mayor prioridad entre los que esperan, -1 si la cola está vacía
+int8_t waitQueueHighestPriority(WaitQueueADT queue);
+// Saca al proceso de la cola en la que esté esperando (si está en alguna)
+void waitQueueRemove(Process *p);
+
+#endif
@@ -12,10 +12,17 @@
 #include <sound.h>
 #include <memory_manager.h>
 #include <semaphore_manager.h>
+#include <futex.h>
+#include <mutex_manager.h>
+#include <condvar_manager.h>
+#include <rwlock_manager.h>
 #include <pipe_manager.h>
+#include <mqueue_manager.h>
+#include <shm_manager.h>
 #include <scheduler.h>
 #include <processes.h>
 #include <keyboard.h>
+#include <deferred_work.h>
 
 // extern uint8_t text;
 // extern uint8_t rodata;
@@ -86,22 +93,35 @@ void * initializeKernelBinary(){
     create_memory_manager(0);
     sched_init(4);
     createSemaphoreManager();
+    createFutexManager();
+    createMutexManager();
+    createCondVarManager();
+    createRWLockManager();
     createPipeManager();
+    createMessageQueueManager();
+    createShmManager();
+    createDeferredWork();
     // Keyboard driver is interrupt-driven; no explicit init function required
 
     return getStackBase();
 }
 
 int main(){ 
+    initVideo();
     setFontSize(2);
 
-    semInit(1, 0);
-    semOpen(1);
+    uint64_t uncachedBandwidth = videoFillBandwidth(DEFAULT_BACKGROUND_COLOR);
+    int8_t writeCombining = videoEnableWriteCombining();
+    uint64_t bandwidth = videoFillBandwidth(DEFAULT_BACKGROUND_COLOR);
+    print("Framebuffer fill: "); printDec(uncachedBandwidth); print(" MB/s -> "); printDec(bandwidth);
+    print(writeCombining == 0 ? " MB/s (write-combining)\n" : " MB/s (write-combining not available)\n");
 
     // Create idle process (which will spawn shell)
     char *argsIdle[2] = {"IDLE", NULL};
     int16_t fdIdle[3] = {STDIN, STDOUT, STDERR};
     createProcess((MainFunction)&idle, argsIdle, "IDLE", 0, fdIdle, 1);
+    // Runs what the timer and keyboard handlers defer (cursor, echo, key handlers)
+    startDeferredWorker();
 
     load_idt();
 
@@ -13,6 +13,15 @@ size_t strlen(const char * s)
     return n;
 }
 
+int strcmp(const char * s1, const char * s2)
+{
+    while (*s1 != 0 && *s1 == *s2) {
+        s1++;
+        s2++;
+    }
+    return (uint8_t)*s1 - (uint8_t)*s2;
+}
+
 void * memset(void * destination, int32_t c, uint64_t length)
 {
 	uint8_t chr = (uint8_t)c;
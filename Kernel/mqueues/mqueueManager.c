@@ -0,0 +1,280 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <defs.h>
+#include <lib.h>
+#include <linkedListADT.h>
+#include <memory_manager.h>
+#include <mqueue_manager.h>
+#include <processes.h>
+#include <scheduler.h>
+#include <stdint.h>
+#include <wait_queue.h>
+
+#define NO_SLOT (-1)
+#define alignSlot(size) (((size) + 7) & ~((uint64_t) 7))
+#define slotAt(queue, index) ((MessageHeader *) ((queue)->storage + (uint64_t) (index) * (queue)->slotSize))
+#define payloadOf(header) ((uint8_t *) (header) + sizeof(MessageHeader))
+#define pidToData(pid) ((void *) ((uint64_t) (pid)))
+
+// Cabecera de cada slot del almacenamiento preasignado. Los slots libres y los
+// mensajes de una misma prioridad se encadenan por índice, sin memoria extra.
+typedef struct MessageHeader {
+	int16_t next;
+	uint16_t length;
+	uint8_t priority;
+} MessageHeader;
+
+typedef struct MessageQueue {
+	char *name; // NULL si es anónima
+	uint16_t maxMessages;
+	uint16_t messageSize;
+	uint16_t slotSize;
+	uint16_t count;
+	LinkedListADT openers; // un nodo por cada create/open, con el pid que lo hizo
+	int16_t freeSlot;
+	int16_t head[MQ_PRIORITIES];
+	int16_t tail[MQ_PRIORITIES];
+	uint8_t usedPriorities; // bit i prendido si hay mensajes de prioridad i
+	uint8_t *storage;
+	WaitQueueADT senders;	// procesos bloqueados por cola llena
+	WaitQueueADT receivers; // procesos bloqueados por cola vacía
+} MessageQueue;
+
+typedef struct MessageQueueManagerCDT {
+	MessageQueue *queues[MQ_MAX_QUEUES];
+	// Cambia cada vez que se libera un id: quien se despierta compara la generación y
+	// no el puntero, que pudo haber sido liberado y reusado por otra cola
+	uint32_t generations[MQ_MAX_QUEUES];
+	uint16_t qtyQueues;
+} MessageQueueManagerCDT;
+
+static MessageQueue *createQueue(const char *name, uint16_t maxMessages, uint16_t messageSize);
+static void freeQueue(MessageQueue *queue);
+static int8_t removeOpener(MessageQueue *queue, uint16_t pid);
+static void releaseQueue(MessageQueueManagerADT manager, uint16_t id);
+
+static MessageQueueManagerADT getMessageQueueManager() {
+	return (MessageQueueManagerADT) MESSAGE_QUEUE_MANAGER_ADDRESS;
+}
+
+static MessageQueue *getQueueById(MessageQueueManagerADT manager, uint16_t id) {
+	if (id >= MQ_MAX_QUEUES)
+		return NULL;
+	return manager->queues[id];
+}
+
+static int16_t getQueueIdByName(MessageQueueManagerADT manager, const char *name) {
+	for (int16_t i = 0; i < MQ_MAX_QUEUES; i++)
+		if (manager->queues[i] != NULL && manager->queues[i]->name != NULL && strcmp(manager->queues[i]->name, name) == 0)
+			return i;
+	return -1;
+}
+
+MessageQueueManagerADT createMessageQueueManager() {
+	MessageQueueManagerADT manager = (MessageQueueManagerADT) MESSAGE_QUEUE_MANAGER_ADDRESS;
+	for (int i = 0; i < MQ_MAX_QUEUES; i++) {
+		manager->queues[i] = NULL;
+		manager->generations[i] = 0;
+	}
+	manager->qtyQueues = 0;
+	return manager;
+}
+
+int16_t mqCreate(const char *name, uint16_t maxMessages, uint16_t messageSize) {
+	MessageQueueManagerADT manager = getMessageQueueManager();
+	if (maxMessages == 0 || maxMessages > MQ_MAX_MESSAGES ||
+		messageSize == 0 || messageSize > MQ_MAX_MESSAGE_SIZE ||
+		manager->qtyQueues >= MQ_MAX_QUEUES)
+		return -1;
+	if (name != NULL && (strlen(name) == 0 || strlen(name) >= MQ_NAME_MAX || getQueueIdByName(manager, name) != -1))
+		return -1;
+
+	int16_t id = 0;
+	while (manager->queues[id] != NULL)
+		id++;
+	MessageQueue *queue = createQueue(name, maxMessages, messageSize);
+	if (queue == NULL)
+		return -1;
+	if (appendElement(queue->openers, pidToData(getpid())) == NULL) {
+		freeQueue(queue);
+		return -1;
+	}
+	manager->queues[id] = queue;
+	manager->qtyQueues++;
+	return id;
+}
+
+int16_t mqOpen(const char *name) {
+	if (name == NULL)
+		return -1;
+	MessageQueueManagerADT manager = getMessageQueueManager();
+	int16_t id = getQueueIdByName(manager, name);
+	if (id != -1 && appendElement(manager->queues[id]->openers, pidToData(getpid())) == NULL)
+		return -1;
+	return id;
+}
+
+// Solo puede cerrar quien la abrió
+int8_t mqClose(uint16_t id) {
+	MessageQueueManagerADT manager = getMessageQueueManager();
+	MessageQueue *queue = getQueueById(manager, id);
+	if (queue == NULL || removeOpener(queue, getpid()) == -1)
+		return -1;
+	if (isEmpty(queue->openers))
+		releaseQueue(manager, id);
+	return 0;
+}
+
+void mqCloseAllForPid(uint16_t pid) {
+	MessageQueueManagerADT manager = getMessageQueueManager();
+	for (uint16_t i = 0; i < MQ_MAX_QUEUES && manager->qtyQueues > 0; i++) {
+		MessageQueue *queue = manager->queues[i];
+		if (queue == NULL)
+			continue;
+		uint8_t closed = 0;
+		while (removeOpener(queue, pid) == 0)
+			closed = 1;
+		if (closed && isEmpty(queue->openers))
+			releaseQueue(manager, i);
+	}
+}
+
+int64_t mqSend(uint16_t id, const void *message, uint16_t length, uint8_t priority, uint8_t flags) {
+	MessageQueueManagerADT manager = getMessageQueueManager();
+	MessageQueue *queue = getQueueById(manager, id);
+	if (queue == NULL || message == NULL || length > queue->messageSize || priority >= MQ_PRIORITIES)
+		return -1;
+
+	uint32_t generation = manager->generations[id];
+	while (queue->count == queue->maxMessages) {
+		if (flags & MQ_NONBLOCK)
+			return -1;
+		waitQueueSleep(queue->senders);
+		if (manager->generations[id] != generation) // Validar que no se haya cerrado la cola
+			return -1;
+	}
+
+	int16_t slot = queue->freeSlot;
+	MessageHeader *header = slotAt(queue, slot);
+	queue->freeSlot = header->next;
+	header->next = NO_SLOT;
+	header->length = length;
+	header->priority = priority;
+	memcpy(payloadOf(header), message, length);
+
+	if (queue->tail[priority] == NO_SLOT)
+		queue->head[priority] = slot;
+	else
+		slotAt(queue, queue->tail[priority])->next = slot;
+	queue->tail[priority] = slot;
+	queue->usedPriorities |= (uint8_t) (1 << priority);
+	queue->count++;
+
+	waitQueueWakeOne(queue->receivers);
+	return length;
+}
+
+int64_t mqReceive(uint16_t id, void *buffer, uint16_t length, uint8_t *priority, uint8_t flags) {
+	MessageQueueManagerADT manager = getMessageQueueManager();
+	MessageQueue *queue = getQueueById(manager, id);
+	if (queue == NULL || buffer == NULL)
+		return -1;
+
+	uint32_t generation = manager->generations[id];
+	while (queue->count == 0) {
+		if (flags & MQ_NONBLOCK)
+			return -1;
+		waitQueueSleep(queue->receivers);
+		if (manager->generations[id] != generation)
+			return -1;
+	}
+
+	uint8_t level = MQ_PRIORITIES - 1;
+	while (!(queue->usedPriorities & (1 << level)))
+		level--;
+
+	int16_t slot = queue->head[level];
+	MessageHeader *header = slotAt(queue, slot);
+	if (header->length > length) // El mensaje queda en la cola
+		return -1;
+
+	memcpy(buffer, payloadOf(header), header->length);
+	if (priority != NULL)
+		*priority = level;
+
+	queue->head[level] = header->next;
+	if (queue->head[level] == NO_SLOT) {
+		queue->tail[level] = NO_SLOT;
+		queue->usedPriorities &= (uint8_t) ~(1 << level);
+	}
+	header->next = queue->freeSlot;
+	queue->freeSlot = slot;
+	queue->count--;
+
+	waitQueueWakeOne(queue->senders);
+	return header->length;
+}
+
+static MessageQueue *createQueue(const char *name, uint16_t maxMessages, uint16_t messageSize) {
+	MessageQueue *queue = (MessageQueue *) mm_malloc(sizeof(MessageQueue));
+	if (queue == NULL)
+		return NULL;
+	queue->slotSize = alignSlot(sizeof(MessageHeader) + messageSize);
+	queue->storage = (uint8_t *) mm_malloc((uint64_t) maxMessages * queue->slotSize);
+	queue->name = NULL;
+	if (name != NULL)
+		queue->name = (char *) mm_malloc(strlen(name) + 1);
+	if (queue->storage == NULL || (name != NULL && queue->name == NULL)) {
+		mm_free(queue->storage);
+		mm_free(queue->name);
+		mm_free(queue);
+		return NULL;
+	}
+	if (name != NULL)
+		memcpy(queue->name, name, strlen(name) + 1);
+
+	queue->maxMessages = maxMessages;
+	queue->messageSize = messageSize;
+	queue->count = 0;
+	queue->usedPriorities = 0;
+	for (int i = 0; i < MQ_PRIORITIES; i++) {
+		queue->head[i] = NO_SLOT;
+		queue->tail[i] = NO_SLOT;
+	}
+	for (uint16_t i = 0; i < maxMessages; i++)
+		slotAt(queue, i)->next = i + 1 < maxMessages ? (int16_t) (i + 1) : NO_SLOT;
+	queue->freeSlot = 0;
+	queue->senders = createWaitQueue();
+	queue->receivers = createWaitQueue();
+	queue->openers = createLinkedListADT();
+	return queue;
+}
+
+static int8_t removeOpener(MessageQueue *queue, uint16_t pid) {
+	for (Node *node = getFirst(queue->openers); node != NULL; node = node->next) {
+		if (node->data == pidToData(pid)) {
+			removeNode(queue->openers, node);
+			mm_free(node);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+static void releaseQueue(MessageQueueManagerADT manager, uint16_t id) {
+	MessageQueue *queue = manager->queues[id];
+	manager->queues[id] = NULL;
+	manager->generations[id]++;
+	manager->qtyQueues--;
+	freeQueue(queue);
+}
+
+// Los procesos bloqueados se despiertan y ven que la cola ya no existe
+static void freeQueue(MessageQueue *queue) {
+	freeWaitQueue(queue->senders);
+	freeWaitQueue(queue->receivers);
+	freeLinkedListADTDeep(queue->openers);
+	mm_free(queue->storage);
+	mm_free(queue->name);
+	mm_free(queue);
+}
@@ -1,4 +1,3 @@
-
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include <defs.h>
@@ -9,19 +8,22 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <lib.h>
+#include <wait_queue.h>
 
 #define MAX_PIPES (1 << 12)
 #define bufferPosition(pipe) (((pipe)->startPosition + (pipe)->currentSize) % PIPE_SIZE)
 
+// Los extremos no pertenecen a un pid: cuentan cuántos archivos abiertos los
+// referencian, así un pipe puede tener varios lectores y escritores (dup, hijos)
 typedef struct Pipe {
 	char buffer[PIPE_SIZE];
 	uint16_t startPosition;
 	uint16_t currentSize;
-	int16_t inputPid, outputPid;
-	uint8_t isBlocking;
+	uint16_t readers, writers;
+	WaitQueueADT readersQueue; // bloqueados por pipe vacío
+	WaitQueueADT writersQueue; // bloqueados por pipe lleno
 } Pipe;
 
-static int16_t getPipeIndexById(uint16_t id);
 static Pipe *getPipeById(PipeManagerADT pipeManager, uint16_t id);
 static void freePipe(Pipe *pipe);
 static Pipe *createPipe();
@@ -36,18 +38,10 @@ static PipeManagerADT getPipeManager() {
 	return (PipeManagerADT) PIPE_MANAGER_ADDRESS;
 }
 
-static int16_t getPipeIndexById(uint16_t id) {
-	int16_t index = (int16_t) id - BUILT_IN_DESCRIPTORS;
-	if (index < 0 || index >= MAX_PIPES)
-		return -1;
-	return index;
-}
-
 static Pipe *getPipeById(PipeManagerADT pipeManager, uint16_t id) {
-	int16_t index;
-	if ((index = getPipeIndexById(id)) == -1)
+	if (id >= MAX_PIPES)
 		return NULL;
-	return pipeManager->pipes[index];
+	return pipeManager->pipes[id];
 }
 
 PipeManagerADT createPipeManager() {
@@ -59,144 +53,128 @@ PipeManagerADT createPipeManager() {
 	return pipeManager;
 }
 
-int16_t getLastFreePipe() {
+int16_t pipeCreate() {
 	PipeManagerADT pipeManager = getPipeManager();
 	if (pipeManager->qtyPipes >= MAX_PIPES)
 		return -1;
 	while (pipeManager->pipes[pipeManager->lastFreePipe] != NULL)
 		pipeManager->lastFreePipe = (pipeManager->lastFreePipe + MAX_PIPES - 1) % MAX_PIPES;
 	Pipe *pipe = createPipe();
+	if (pipe == NULL)
+		return -1;
 	pipeManager->pipes[pipeManager->lastFreePipe] = pipe;
 	pipeManager->qtyPipes++;
-	return pipeManager->lastFreePipe + BUILT_IN_DESCRIPTORS;
-}
-
-int8_t pipeOpen(uint16_t id, uint8_t mode) {
-	return pipeOpenForPid(getpid(), id, mode);
+	return pipeManager->lastFreePipe;
 }
 
-int8_t pipeOpenForPid(uint16_t pid, uint16_t id, uint8_t mode) {
-	int16_t index;
-	if ((index = getPipeIndexById(id)) == -1)
+int8_t pipeAttach(uint16_t id, uint8_t mode) {
+	Pipe *pipe = getPipeById(getPipeManager(), id);
+	if (pipe == NULL)
 		return -1;
-	PipeManagerADT pipeManager = getPipeManager();
-	Pipe *pipe = pipeManager->pipes[index];
-	pipeManager->qtyPipes++;
-	if (pipe == NULL) {
-		pipe = createPipe();
-		pipeManager->pipes[index] = pipe;
-	}
-	if (mode == READ && pipe->outputPid < 0)
-		pipe->outputPid = pid;
-	else if (mode == WRITE && pipe->inputPid < 0)
-		pipe->inputPid = pid;
+	if (mode == READ)
+		pipe->readers++;
 	else
-		return -1;
+		pipe->writers++;
 	return 0;
 }
 
-int8_t pipeClose(uint16_t id) {
-	return pipeCloseForPid(getpid(), id);
-}
-
-int8_t pipeCloseForPid(uint16_t pid, uint16_t id) {
+int8_t pipeDetach(uint16_t id, uint8_t mode) {
 	PipeManagerADT pipeManager = getPipeManager();
-	int16_t index;
-	if ((index = getPipeIndexById(id)) == -1)
-		return -1;
-	Pipe *pipe = pipeManager->pipes[index];
-	if (pipe == NULL)
+	Pipe *pipe = getPipeById(pipeManager, id);
+	if (pipe == NULL || (mode == READ ? pipe->readers : pipe->writers) == 0)
 		return -1;
 
-	if (pid == pipe->inputPid) {
-		char eofString[1] = {EOF};
-		writePipe(pid, id, eofString, 1);
-	}
-	else if (pid == pipe->outputPid) {
-		freePipe(pipeManager->pipes[index]);
-		pipeManager->pipes[index] = NULL;
+	if (mode == READ && --pipe->readers == 0)
+		waitQueueWakeAll(pipe->writersQueue); // Escriben a un pipe sin lectores
+	else if (mode == WRITE && --pipe->writers == 0)
+		waitQueueWakeAll(pipe->readersQueue); // Leen el EOF
+
+	if (pipe->readers == 0 && pipe->writers == 0) {
+		pipeManager->pipes[id] = NULL;
 		pipeManager->qtyPipes--;
+		freePipe(pipe);
 	}
-	else
+	return 0;
+}
+
+int8_t pipeDestroy(uint16_t id) {
+	PipeManagerADT pipeManager = getPipeManager();
+	Pipe *pipe = getPipeById(pipeManager, id);
+	if (pipe == NULL || pipe->readers > 0 || pipe->writers > 0)
 		return -1;
+	pipeManager->pipes[id] = NULL;
+	pipeManager->qtyPipes--;
+	freePipe(pipe);
 	return 0;
 }
+
 static void freePipe(Pipe *pipe) {
-    mm_free(pipe);
+	freeWaitQueue(pipe->readersQueue);
+	freeWaitQueue(pipe->writersQueue);
+	mm_free(pipe);
 }
 
 static Pipe *createPipe() {
-    Pipe *pipe = (Pipe *) mm_malloc(sizeof(Pipe));
+	Pipe *pipe = (Pipe *) mm_malloc(sizeof(Pipe));
+	if (pipe == NULL)
+		return NULL;
 	pipe->startPosition = 0;
 	pipe->currentSize = 0;
-	pipe->inputPid = -1;
-	pipe->outputPid = -1;
-	pipe->isBlocking = 0;
-	for (int i = 0; i < PIPE_SIZE; i++)
-		pipe->buffer[i] = 0;
+	pipe->readers = 0;
+	pipe->writers = 0;
+	pipe->readersQueue = createWaitQueue();
+	pipe->writersQueue = createWaitQueue();
 	return pipe;
 }
 
-int64_t writePipe(uint16_t pid, uint16_t id, char *sourceBuffer, uint64_t len) {
+// Devuelve -1 si no quedan lectores y no se llegó a escribir nada
+int64_t writePipe(uint16_t id, char *sourceBuffer, uint64_t len) {
 	PipeManagerADT pipeManager = getPipeManager();
 	Pipe *pipe = getPipeById(pipeManager, id);
-	if (pipe == NULL ||
-		pipe->inputPid != pid ||
-		len == 0)
+	if (pipe == NULL || len == 0)
 		return -1;
 
 	uint64_t writtenBytes = 0;
-	while (writtenBytes < len && (int) pipe->buffer[bufferPosition(pipe)] != EOF) {
+	while (writtenBytes < len && pipe->readers > 0) {
 		if (pipe->currentSize >= PIPE_SIZE) {
-			pipe->isBlocking = 1;
-			setStatus((uint16_t) pipe->inputPid, BLOCKED);
-			yield();
+			waitQueueSleep(pipe->writersQueue);
+			if (pipe != getPipeById(pipeManager, id)) // Validar que no haya muerto el pipe
+				return writtenBytes;
+			continue;
 		}
-		if (pipe != getPipeById(pipeManager, id)) // Validar que no haya muerto el pipe
-			return -1;
-
 		while (pipe->currentSize < PIPE_SIZE && writtenBytes < len) {
-			pipe->buffer[bufferPosition(pipe)] = sourceBuffer[writtenBytes];
-			if ((int) sourceBuffer[writtenBytes++] == EOF)
-				break;
+			pipe->buffer[bufferPosition(pipe)] = sourceBuffer[writtenBytes++];
 			pipe->currentSize++;
 		}
-		if (pipe->isBlocking) {
-			setStatus((uint16_t) pipe->outputPid, READY);
-			pipe->isBlocking = 0;
-		}
+		waitQueueWakeAll(pipe->readersQueue);
 	}
-	return writtenBytes;
+	return writtenBytes == 0 ? -1 : (int64_t) writtenBytes;
 }
 
+// Bloquea solo hasta que haya algo y devuelve lo disponible, así un lector con un buffer
+// grande no espera a llenarlo. Sin escritores y con el pipe vacío devuelve 0 (EOF).
 int64_t readPipe(uint16_t id, char *destinationBuffer, uint64_t len) {
 	PipeManagerADT pipeManager = getPipeManager();
 	Pipe *pipe = getPipeById(pipeManager, id);
-	if (pipe == NULL ||
-		pipe->outputPid != getpid() ||
-		len == 0)
+	if (pipe == NULL || len == 0)
 		return -1;
-	uint8_t eofRead = 0;
+
 	uint64_t readBytes = 0;
-	while (readBytes < len && !eofRead) {
-		if (pipe->currentSize == 0 && (int) pipe->buffer[pipe->startPosition] != EOF) {
-			pipe->isBlocking = 1;
-			setStatus((uint16_t) pipe->outputPid, BLOCKED);
-			yield();
+	while (readBytes == 0) {
+		if (pipe->currentSize == 0) {
+			if (pipe->writers == 0)
+				return 0;
+			waitQueueSleep(pipe->readersQueue);
+			if (pipe != getPipeById(pipeManager, id))
+				return readBytes;
+			continue;
 		}
-		while ((pipe->currentSize > 0 || (int) pipe->buffer[pipe->startPosition] == EOF) && readBytes < len) {
-			destinationBuffer[readBytes] = pipe->buffer[pipe->startPosition];
-			if ((int) destinationBuffer[readBytes++] == EOF) {
-				eofRead = 1;
-				break;
-			}
-			pipe->currentSize--;
+		while (pipe->currentSize > 0 && readBytes < len) {
+			destinationBuffer[readBytes++] = pipe->buffer[pipe->startPosition];
 			pipe->startPosition = (pipe->startPosition + 1) % PIPE_SIZE;
+			pipe->currentSize--;
 		}
-		if (pipe->isBlocking) {
-			setStatus((uint16_t) pipe->inputPid, READY);
-			pipe->isBlocking = 0;
-		}
+		waitQueueWakeAll(pipe->writersQueue);
 	}
 	return readBytes;
 }
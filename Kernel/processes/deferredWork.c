@@ -0,0 +1,80 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <defs.h>
+#include <deferred_work.h>
+#include <interrupts.h>
+#include <processes.h>
+#include <stdint.h>
+#include <wait_queue.h>
+
+typedef struct DeferredItem {
+	DeferredFunction fn;
+	uint64_t arg;
+} DeferredItem;
+
+// Anillo fijo: encolar desde un ISR nunca pide memoria
+typedef struct DeferredWorkCDT {
+	DeferredItem items[DEFERRED_WORK_SLOTS];
+	uint16_t head;
+	uint16_t count;
+	WaitQueueADT worker;
+} DeferredWorkCDT;
+
+static DeferredWorkADT getDeferredWork() {
+	return (DeferredWorkADT) DEFERRED_WORK_ADDRESS;
+}
+
+DeferredWorkADT createDeferredWork() {
+	DeferredWorkADT work = (DeferredWorkADT) DEFERRED_WORK_ADDRESS;
+	work->head = 0;
+	work->count = 0;
+	work->worker = createWaitQueue();
+	return work;
+}
+
+int8_t deferWork(DeferredFunction fn, uint64_t arg) {
+	DeferredWorkADT work = getDeferredWork();
+	if (fn == NULL)
+		return -1;
+	uint64_t flags = _cliSave();
+	if (work->count == DEFERRED_WORK_SLOTS) {
+		_restoreFlags(flags);
+		return -1;
+	}
+	DeferredItem *item = &work->items[(work->head + work->count) % DEFERRED_WORK_SLOTS];
+	item->fn = fn;
+	item->arg = arg;
+	work->count++;
+	waitQueueWakeOne(work->worker);
+	_restoreFlags(flags);
+	return 0;
+}
+
+// Cada trabajo corre con las interrupciones deshabilitadas, como una syscall, porque la
+// consola y el video no son reentrantes. Entre uno y otro pueden entrar interrupciones y
+// el worker puede ser desalojado, así que ningún ISR espera a que se dibuje nada. Un
+// trabajo largo (el flush del video) las habilita él mismo entre tramos.
+static int deferredWorker(int argc, char **argv) {
+	(void) argc;
+	(void) argv;
+	DeferredWorkADT work = getDeferredWork();
+	while (1) {
+		uint64_t flags = _cliSave();
+		while (work->count == 0)
+			waitQueueSleep(work->worker);
+		DeferredItem item = work->items[work->head];
+		work->head = (work->head + 1) % DEFERRED_WORK_SLOTS;
+		work->count--;
+		item.fn(item.arg);
+		_restoreFlags(flags);
+	}
+	return 0;
+}
+
+// Sin stdin, para no tomar el foco del teclado. Los handlers de teclas de los procesos no
+// corren acá sino en cada proceso, que tiene sus propios descriptores
+int16_t startDeferredWorker() {
+	char *argv[2] = {"kworker", NULL};
+	int16_t fileDescriptors[3] = {DEV_NULL, STDOUT, STDERR};
+	return createProcess(deferredWorker, argv, "kworker", MAX_PRIORITY, fileDescriptors, 1);
+}
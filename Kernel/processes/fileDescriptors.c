@@ -0,0 +1,218 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <file_descriptors.h>
+#include <fonts.h>
+#include <keyboard.h>
+#include <lib.h>
+#include <memory_manager.h>
+#include <pipe_manager.h>
+#include <processes.h>
+#include <stdint.h>
+
+static OpenFile *openFile(FileType type, uint16_t pipeId);
+static OpenFile *retainFile(OpenFile *file);
+static void releaseFile(OpenFile *file);
+static int16_t installFile(Process *p, OpenFile *file);
+static int8_t growTable(Process *p, uint16_t minCapacity);
+
+static int8_t validFd(const Process *p, int16_t fd) {
+	return p != NULL && fd >= 0 && fd < p->fdCapacity;
+}
+
+int8_t fdTableInit(Process *p, Process *parent, const int16_t fileDescriptors[3]) {
+	p->fdCapacity = 0;
+	p->fdTable = NULL;
+	if (growTable(p, FD_INITIAL_CAPACITY) == -1)
+		return -1;
+
+	for (int16_t fd = 0; fd < BUILT_IN_DESCRIPTORS; fd++) {
+		int16_t parentFd = fileDescriptors == NULL ? fd : fileDescriptors[fd];
+		OpenFile *file;
+		if (parentFd == DEV_NULL)
+			file = openFile(NULL_DEVICE, 0);
+		else if (parent != NULL && parent->fdTable != NULL)
+			file = retainFile(fdGet(parent, parentFd));
+		else // Procesos del kernel: los descriptores 0..2 son la consola
+			file = parentFd >= STDIN && parentFd <= STDERR ? openFile((FileType) parentFd, 0) : NULL;
+		if (file == NULL)
+			file = openFile(NULL_DEVICE, 0);
+		p->fdTable[fd] = file;
+	}
+	return 0;
+}
+
+void fdTableFree(Process *p) {
+	if (p == NULL || p->fdTable == NULL)
+		return;
+	for (int16_t fd = 0; fd < p->fdCapacity; fd++)
+		fdClose(p, fd);
+	mm_free(p->fdTable);
+	p->fdTable = NULL;
+	p->fdCapacity = 0;
+}
+
+OpenFile *fdGet(const Process *p, int16_t fd) {
+	if (!validFd(p, fd))
+		return NULL;
+	return p->fdTable[fd];
+}
+
+int8_t fdIsType(const Process *p, int16_t fd, FileType type) {
+	OpenFile *file = fdGet(p, fd);
+	return file != NULL && file->type == type;
+}
+
+int8_t fdPipe(Process *p, int16_t fds[2]) {
+	int16_t pipeId = pipeCreate();
+	if (pipeId == -1)
+		return -1;
+	OpenFile *readEnd = openFile(PIPE_READ, pipeId);
+	OpenFile *writeEnd = openFile(PIPE_WRITE, pipeId);
+	if (readEnd == NULL || writeEnd == NULL) {
+		if (readEnd == NULL && writeEnd == NULL) // Sin extremos, nadie lo va a soltar
+			pipeDestroy(pipeId);
+		releaseFile(readEnd); // Soltar el único extremo libera el pipe
+		releaseFile(writeEnd);
+		return -1;
+	}
+	fds[READ] = installFile(p, readEnd);
+	fds[WRITE] = installFile(p, writeEnd);
+	if (fds[READ] == -1 || fds[WRITE] == -1) {
+		if (fds[READ] != -1)
+			fdClose(p, fds[READ]);
+		else
+			releaseFile(readEnd);
+		if (fds[WRITE] != -1)
+			fdClose(p, fds[WRITE]);
+		else
+			releaseFile(writeEnd);
+		return -1;
+	}
+	return 0;
+}
+
+int16_t fdDup(Process *p, int16_t fd) {
+	OpenFile *file = fdGet(p, fd);
+	if (file == NULL)
+		return -1;
+	int16_t newFd = installFile(p, file);
+	if (newFd != -1)
+		retainFile(file);
+	return newFd;
+}
+
+int16_t fdDup2(Process *p, int16_t fd, int16_t newFd) {
+	OpenFile *file = fdGet(p, fd);
+	if (file == NULL || newFd < 0 || newFd >= FD_MAX_CAPACITY)
+		return -1;
+	if (fd == newFd)
+		return newFd;
+	if (newFd >= p->fdCapacity && growTable(p, newFd + 1) == -1)
+		return -1;
+	fdClose(p, newFd);
+	p->fdTable[newFd] = retainFile(file);
+	return newFd;
+}
+
+int8_t fdClose(Process *p, int16_t fd) {
+	OpenFile *file = fdGet(p, fd);
+	if (file == NULL)
+		return -1;
+	p->fdTable[fd] = NULL;
+	releaseFile(file);
+	return 0;
+}
+
+int64_t fdRead(Process *p, int16_t fd, char *buffer, uint64_t len) {
+	OpenFile *file = fdGet(p, fd);
+	if (file == NULL)
+		return -1;
+	switch (file->type) {
+		case PIPE_READ:
+			return readPipe(file->pipeId, buffer, len);
+		case CONSOLE_IN:
+			return readConsole(buffer, len);
+		case NULL_DEVICE:
+			return 0;
+		default:
+			return -1;
+	}
+}
+
+int64_t fdWrite(Process *p, int16_t fd, const char *buffer, uint64_t len) {
+	OpenFile *file = fdGet(p, fd);
+	if (file == NULL)
+		return -1;
+	switch (file->type) {
+		case PIPE_WRITE:
+			return writePipe(file->pipeId, (char *) buffer, len);
+		case CONSOLE_IN:
+		case CONSOLE_OUT:
+		case CONSOLE_ERR: // printToFd usa 0..2 para la consola, en el mismo orden que FileType
+			return printToFd((int32_t) file->type, buffer, (int32_t) len);
+		case NULL_DEVICE:
+			return len;
+		default:
+			return -1;
+	}
+}
+
+static OpenFile *openFile(FileType type, uint16_t pipeId) {
+	OpenFile *file = (OpenFile *) mm_malloc(sizeof(OpenFile));
+	if (file == NULL)
+		return NULL;
+	file->type = type;
+	file->pipeId = pipeId;
+	file->references = 1;
+	if (type == PIPE_READ || type == PIPE_WRITE)
+		pipeAttach(pipeId, type == PIPE_READ ? READ : WRITE);
+	return file;
+}
+
+static OpenFile *retainFile(OpenFile *file) {
+	if (file != NULL)
+		file->references++;
+	return file;
+}
+
+// El extremo del pipe se suelta recién cuando no queda ningún descriptor que lo use
+static void releaseFile(OpenFile *file) {
+	if (file == NULL || --file->references > 0)
+		return;
+	if (file->type == PIPE_READ || file->type == PIPE_WRITE)
+		pipeDetach(file->pipeId, file->type == PIPE_READ ? READ : WRITE);
+	mm_free(file);
+}
+
+// Ocupa el descriptor libre más bajo; la tabla se duplica cuando se llena
+static int16_t installFile(Process *p, OpenFile *file) {
+	if (p == NULL || file == NULL)
+		return -1;
+	int16_t fd = 0;
+	while (fd < p->fdCapacity && p->fdTable[fd] != NULL)
+		fd++;
+	if (fd == p->fdCapacity && growTable(p, p->fdCapacity * 2) == -1)
+		return -1;
+	p->fdTable[fd] = file;
+	return fd;
+}
+
+static int8_t growTable(Process *p, uint16_t minCapacity) {
+	uint16_t capacity = p->fdCapacity == 0 ? FD_INITIAL_CAPACITY : p->fdCapacity;
+	while (capacity < minCapacity)
+		capacity *= 2;
+	if (capacity > FD_MAX_CAPACITY)
+		capacity = FD_MAX_CAPACITY;
+	if (capacity < minCapacity || capacity == p->fdCapacity)
+		return -1;
+
+	OpenFile **table = (OpenFile **) mm_malloc(capacity * sizeof(OpenFile *));
+	if (table == NULL)
+		return -1;
+	for (uint16_t i = 0; i < capacity; i++)
+		table[i] = i < p->fdCapacity ? p->fdTable[i] : NULL;
+	mm_free(p->fdTable);
+	p->fdTable = table;
+	p->fdCapacity = capacity;
+	return 0;
+}
@@ -9,10 +9,18 @@
 #include <defs.h>
 #include <memory_manager.h>
 #include <linkedListADT.h>
-#include <pipe_manager.h>
+#include <file_descriptors.h>
+#include <shm_manager.h>
+#include <mqueue_manager.h>
+#include <mutex_manager.h>
+#include <rwlock_manager.h>
+#include <semaphore_manager.h>
+#include <wait_queue.h>
 #include <processes.h>
 #include <scheduler.h>
 #include <interrupts.h>
+#include <video.h>
+#include <keyboard.h>
 
 static uint16_t next_pid = 1;
 // Simple PID reuse stack. When a process is fully destroyed,
@@ -42,32 +50,16 @@ static int count_args(char **argv) {
     return count;
 }
 
-static void assignFileDescriptor(Process *p, uint8_t idx, int16_t fdValue, uint8_t mode) {
-    if (p == NULL || idx >= 3) {
-        return;
-    }
-    
-    p->fileDescriptors[idx] = fdValue;
-    
-    if (fdValue >= BUILT_IN_DESCRIPTORS) {
-        pipeOpenForPid(p->pid, fdValue, mode);
-    }
-}
 
-static void closeOneFD(uint16_t pid, int16_t fdValue) {
-    if (fdValue >= BUILT_IN_DESCRIPTORS) {
-        pipeCloseForPid(pid, fdValue);
-    }
-}
 
-void initProcess(Process *p,
+int8_t initProcess(Process *p,
                  uint16_t pid, uint16_t parentPid,
                  MainFunction code, char **args, const char *name,
                  uint8_t priority, const int16_t fileDescriptors[3],
                  uint8_t unkillable) {
     
     if (p == NULL || name == NULL || priority > MAX_PRIORITY) {
-        return;
+        return -1;
     }
     
     p->pid = pid;
@@ -77,17 +69,27 @@ void initProcess(Process *p,
     p->unkillable = unkillable;
     p->waitingForPid = 0;
     p->retValue = 0;
+    p->waitQueue = NULL;
+    p->waitChannel = NULL;
+    p->inheritedPriority = -1;
+    p->basePriority = priority;
+    p->job = NULL;
+    p->jobNode = NULL;
+    p->localStorage = NULL;
+    p->exitHook = NULL;
+    p->fdTable = NULL;
+    p->fdCapacity = 0;
     
     p->stackBase = mm_malloc(STACK_SIZE);
     if (p->stackBase == NULL) {
-        return;
+        return -1;
     }
     
     size_t nameLen = strlen(name) + 1;
     p->name = mm_malloc(nameLen);
     if (p->name == NULL) {
         mm_free(p->stackBase);
-        return;
+        return -1;
     }
     memcpy(p->name, name, nameLen);
     
@@ -105,7 +107,7 @@ void initProcess(Process *p,
         if (contiguousBlock == NULL) {
             mm_free(p->stackBase);
             mm_free(p->name);
-            return;
+            return -1;
         }
         
         p->argv = (char**)contiguousBlock;
@@ -129,17 +131,19 @@ void initProcess(Process *p,
         if (p->argv != NULL) {
             mm_free(p->argv);
         }
-        return;
+        return -1;
     }
     
-    if (fileDescriptors != NULL) {
-        assignFileDescriptor(p, STDIN, fileDescriptors[STDIN], READ);
-        assignFileDescriptor(p, STDOUT, fileDescriptors[STDOUT], WRITE);
-        assignFileDescriptor(p, STDERR, fileDescriptors[STDERR], WRITE);
-    } else {
-        p->fileDescriptors[STDIN] = STDIN;
-        p->fileDescriptors[STDOUT] = STDOUT;
-        p->fileDescriptors[STDERR] = STDERR;
+    // Los descriptores del hijo son copias de los del padre (el proceso que lo crea)
+    if (fdTableInit(p, getProcess(parentPid), fileDescriptors) == -1) {
+        fdTableFree(p);
+        freeLinkedListADT(p->zombieChildren);
+        mm_free(p->stackBase);
+        mm_free(p->name);
+        if (p->argv != NULL) {
+            mm_free(p->argv);
+        }
+        return -1;
     }
     
     void *stack_end = (char*)p->stackBase + STACK_SIZE;
@@ -147,6 +151,7 @@ void initProcess(Process *p,
     stack_end = (void*)stack_end_aligned;
     
     p->stackPos = _initialize_stack_frame(processWrapper, (void*)code, stack_end, (void*)code, (void*)p->argv);
+    return 0;
 }
 
 uint16_t createProcess(MainFunction code,
@@ -164,11 +169,36 @@ if (reusableCount > 0) {
 } else {
     pid = next_pid++;
 }
-initProcess(p, pid, parent, code, args, name, priority, fileDescriptors, unkillable);
+if (initProcess(p, pid, parent, code, args, name, priority, fileDescriptors, unkillable) == -1) {
+        mm_free(p);
+        releasePid(pid);
+        return -1;
+    }
+    // Un trabajo en primer plano que lanza la shell (o el kernel) toma el foco del teclado;
+    // los hijos que cree ese trabajo con la consola como entrada entran a su trabajo,
+    // comparten su cola y mueren con él ante un Ctrl+C. Sin la consola, lideran uno propio
+    int32_t focused = getFocusedPid();
+    Process *parentProcess = getProcess(parent);
+    uint8_t consoleInput = fdIsType(p, STDIN, CONSOLE_IN);
+    uint8_t takesFocus = consoleInput && (focused == -1 || (focused == parent && parentProcess != NULL && parentProcess->unkillable));
+    if (jobJoin(p, takesFocus || !consoleInput) == -1) {
+        fdTableFree(p);
+        freeProcess(p);
+        mm_free(p);
+        releasePid(pid);
+        return -1;
+    }
     if (sched_register_process(p) == -1) {
+        jobLeave(p);
+        fdTableFree(p);
+        freeProcess(p);
         mm_free(p);
+        releasePid(pid);
         return -1;
     }
+    if (takesFocus) {
+        inputFocusPush(pid);
+    }
     return pid;
 }
 
@@ -179,6 +209,12 @@ void processWrapper(void *fn, void *argv_ptr) {
     
     int argc = count_args(args);
     int ret = code(argc, args);
+
+    // Userland vacía sus buffers antes de morir (solo si terminó por su cuenta)
+    Process *self = getCurrentProcess();
+    if (self != NULL && self->exitHook != NULL) {
+        self->exitHook();
+    }
     
     killCurrentProcess(ret);
     // Nunca volver a ejecutar código del proceso luego de solicitar su finalización.
@@ -188,14 +224,23 @@ void processWrapper(void *fn, void *argv_ptr) {
     }
 }
 
-void closeFileDescriptors(Process *p) {
+void releaseProcessResources(Process *p) {
     if (p == NULL) {
         return;
     }
-    
-    closeOneFD(p->pid, p->fileDescriptors[STDIN]);
-    closeOneFD(p->pid, p->fileDescriptors[STDOUT]);
-    closeOneFD(p->pid, p->fileDescriptors[STDERR]);
+
+    waitQueueRemove(p);
+    fdTableFree(p);
+    shmDetachAll(p->pid);
+    mqCloseAllForPid(p->pid);
+    semCloseAllForPid(p->pid);
+    mutexReleaseAllForPid(p->pid);
+    rwlockReleaseAllForPid(p->pid);
+    releaseFramebuffer(p->pid);
+    releaseConsoleMode(p->pid);
+    keyEventsClose(p->pid);
+    inputFocusRemove(p->pid);
+    jobLeave(p);
 }
 
 void freeProcess(Process *p) {
@@ -219,6 +264,10 @@ void freeProcess(Process *p) {
     if (p->argv != NULL) {
         mm_free(p->argv);
     }
+
+    if (p->localStorage != NULL) {
+        mm_free(p->localStorage);
+    }
 }
 
 int processIsWaiting(Process *p, uint16_t pidToWait) {
@@ -268,7 +317,7 @@ ProcessSnapshot * loadSnapshot(ProcessSnapshot *dst, const Process *src) {
         dst->name = NULL;
     }
     
-    dst->foreground = (src->fileDescriptors[STDIN] == STDIN) ? 1 : 0;
+    dst->foreground = fdIsType(src, STDIN, CONSOLE_IN);
     
     return dst;
 }
@@ -16,6 +16,12 @@
 #define IDLE_PID 1
 #define QUANTUM_COEF 2
 
+// Trabajo: los procesos que lanzó un mismo comando. Ctrl+C mata a todos los del trabajo
+// con el foco y a ningún otro
+typedef struct Job {
+	LinkedListADT members;
+} Job;
+
 typedef struct SchedulerCDT {
 	Node *processes[MAX_PROCESSES];
 	LinkedListADT levels[QTY_READY_LEVELS + 1];
@@ -23,7 +29,6 @@ typedef struct SchedulerCDT {
 	uint16_t nextUnusedPid;
 	uint16_t qtyProcesses;
 	int8_t remainingQuantum;
-	int8_t killFgProcess;
 } SchedulerCDT;
 
 SchedulerADT createScheduler() {
@@ -33,7 +38,6 @@ SchedulerADT createScheduler() {
 	for (int i = 0; i < QTY_READY_LEVELS + 1; i++)
 		scheduler->levels[i] = createLinkedListADT();
 	scheduler->nextUnusedPid = 0;
-	scheduler->killFgProcess = 0;
 	return scheduler;
 }
 
@@ -68,6 +72,38 @@ int32_t setPriority(uint16_t pid, uint8_t newPriority) {
 	return newPriority;
 }
 
+// El proceso corre al menos con priority hasta que restorePriority le quite la herencia
+int32_t inheritPriority(uint16_t pid, uint8_t priority) {
+	SchedulerADT scheduler = getSchedulerADT();
+	Node *node = scheduler->processes[pid];
+	if (node == NULL || pid == IDLE_PID || priority >= QTY_READY_LEVELS)
+		return -1;
+	Process *process = (Process *) node->data;
+	if (process->inheritedPriority == -1)
+		process->basePriority = process->priority;
+	if ((int8_t) priority > process->inheritedPriority)
+		process->inheritedPriority = priority;
+	if (process->priority < priority)
+		setPriority(pid, priority);
+	return process->priority;
+}
+
+// inherited es la herencia que le queda (-1 si ninguna); si no hereda más, vuelve a su prioridad original
+int32_t restorePriority(uint16_t pid, int8_t inherited) {
+	SchedulerADT scheduler = getSchedulerADT();
+	Node *node = scheduler->processes[pid];
+	if (node == NULL || pid == IDLE_PID)
+		return -1;
+	Process *process = (Process *) node->data;
+	if (process->inheritedPriority == -1)
+		return process->priority;
+	process->inheritedPriority = inherited;
+	uint8_t newPriority = process->basePriority;
+	if (inherited > (int8_t) newPriority)
+		newPriority = inherited;
+	return setPriority(pid, newPriority);
+}
+
 int8_t setStatus(uint16_t pid, uint8_t newStatus) {
 	SchedulerADT scheduler = getSchedulerADT();
 	Node *node = scheduler->processes[pid];
@@ -96,7 +132,12 @@ int8_t setStatus(uint16_t pid, uint8_t newStatus) {
 		if (oldStatus != BLOCKED)
 			return -1;
 		removeNode(scheduler->levels[BLOCKED_INDEX], node);
-		process->priority = MAX_PRIORITY;
+		// Al despertar sube al máximo, salvo que herede de un mutex: ahí sigue con la
+		// prioridad heredada, que es la que restorePriority espera encontrar
+		if (process->inheritedPriority == -1)
+			process->priority = MAX_PRIORITY;
+		else if ((int8_t) process->priority < process->inheritedPriority)
+			process->priority = process->inheritedPriority;
 		prependNode(scheduler->levels[process->priority], node);
 		scheduler->remainingQuantum = 0;
 		process->state = READY;
@@ -141,20 +182,17 @@ void *schedule(void *prevStackPointer) {
 		if (currentProcess->state == RUNNING) {
 			currentProcess->state = READY;
 			uint8_t newPriority = currentProcess->priority > 0 ? currentProcess->priority - 1 : currentProcess->priority;
+			if ((int8_t) newPriority < currentProcess->inheritedPriority) // No pierde la prioridad heredada
+				newPriority = currentProcess->inheritedPriority;
 			setPriority(currentProcess->pid, newPriority);
 		}
 	}
 
 	scheduler->currentPid = getNextPid(scheduler);
 	currentProcess = scheduler->processes[scheduler->currentPid]->data;
-	if (scheduler->killFgProcess && currentProcess->fileDescriptors[STDIN] == STDIN) {
-		print("Killing foreground process\n");
-		scheduler->killFgProcess = 0;
-		if (killCurrentProcess(-1) != -1)
-			forceTimerTick();
-	}
 	scheduler->remainingQuantum = (MAX_PRIORITY - currentProcess->priority);
 	currentProcess->state = RUNNING;
+	*((void **) PROCESS_LOCAL_STORAGE_ADDRESS) = currentProcess->localStorage;
 	return currentProcess->stackPos;
 }
 
@@ -167,6 +205,7 @@ void sched_init(uint8_t maxPriority) {
 	scheduler->qtyProcesses = 0;
 	scheduler->remainingQuantum = 1;
 	scheduler->nextUnusedPid = 1;
+	*((void **) PROCESS_LOCAL_STORAGE_ADDRESS) = NULL;
 }
 
 int sched_register_process(Process *process) {
@@ -203,7 +242,14 @@ int32_t sched_kill_process(uint16_t pid, int32_t retValue) {
 	return killProcessNoZombie(pid, retValue);
 }
 
+// Mientras hereda, nice cambia la prioridad a la que vuelve y no baja de la heredada
 int32_t sched_set_priority(uint16_t pid, uint8_t newPriority) {
+	Process *process = getProcess(pid);
+	if (process != NULL && process->inheritedPriority != -1 && newPriority < QTY_READY_LEVELS) {
+		process->basePriority = newPriority;
+		if ((int8_t) newPriority < process->inheritedPriority)
+			newPriority = process->inheritedPriority;
+	}
 	return setPriority(pid, newPriority);
 }
 
@@ -240,7 +286,7 @@ int32_t killProcess(uint16_t pid, int32_t retValue) {
 	if (processToKill->state == ZOMBIE || processToKill->unkillable)
 		return -1;
 
-	closeFileDescriptors(processToKill);
+	releaseProcessResources(processToKill);
 
 	uint8_t priorityIndex = processToKill->state != BLOCKED ? processToKill->priority : BLOCKED_INDEX;
 	removeNode(scheduler->levels[priorityIndex], processToKillNode);
@@ -277,7 +323,7 @@ int32_t killProcessNoZombie(uint16_t pid, int32_t retValue) {
 	if (processToKill->state == ZOMBIE || processToKill->unkillable)
 		return -1;
 
-	closeFileDescriptors(processToKill);
+	releaseProcessResources(processToKill);
 
 	uint8_t priorityIndex = processToKill->state != BLOCKED ? processToKill->priority : BLOCKED_INDEX;
 	removeNode(scheduler->levels[priorityIndex], processToKillNode);
@@ -302,6 +348,16 @@ uint16_t getpid() {
 	return scheduler->currentPid;
 }
 
+Process *getCurrentProcess() {
+	return getProcess(getSchedulerADT()->currentPid);
+}
+
+Process *getProcess(uint16_t pid) {
+	SchedulerADT scheduler = getSchedulerADT();
+	Node *processNode = pid < MAX_PROCESSES ? scheduler->processes[pid] : NULL;
+	return processNode == NULL ? NULL : (Process *) processNode->data;
+}
+
 ProcessSnapshotList *getProcessSnapshot() {
 	SchedulerADT scheduler = getSchedulerADT();
 	ProcessSnapshotList *snapshotsArray = mm_malloc(sizeof(ProcessSnapshotList));
@@ -371,23 +427,73 @@ void yield() {
 	forceTimerTick();
 }
 
-int8_t changeFD(uint16_t pid, uint8_t position, int16_t newFd) {
-	SchedulerADT scheduler = getSchedulerADT();
-	Node *processNode = scheduler->processes[pid];
-	if (pid == IDLE_PID || processNode == NULL)
+// El hijo entra al trabajo del padre, salvo que lidere uno nuevo: un comando en primer
+// plano o uno sin la consola como entrada (en segundo plano)
+int8_t jobJoin(Process *process, uint8_t newJob) {
+	Process *parent = getProcess(process->parentPid);
+	Job *job = newJob || parent == NULL || parent == process ? NULL : parent->job;
+	uint8_t created = job == NULL;
+	if (created) {
+		job = mm_malloc(sizeof(Job));
+		if (job == NULL)
+			return -1;
+		job->members = createLinkedListADT();
+		if (job->members == NULL) {
+			mm_free(job);
+			return -1;
+		}
+	}
+	process->jobNode = appendElement(job->members, process);
+	if (process->jobNode == NULL) {
+		if (created) {
+			freeLinkedListADT(job->members);
+			mm_free(job);
+		}
 		return -1;
-	Process *process = (Process *) processNode->data;
-	process->fileDescriptors[position] = newFd;
+	}
+	process->job = job;
 	return 0;
 }
 
-int16_t getCurrentProcessFileDescriptor(uint8_t fdIndex) {
-	SchedulerADT scheduler = getSchedulerADT();
-	Process *process = scheduler->processes[scheduler->currentPid]->data;
-	return process->fileDescriptors[fdIndex];
+// El trabajo se libera con su último miembro
+void jobLeave(Process *process) {
+	Job *job = process->job;
+	if (job == NULL)
+		return;
+	removeNode(job->members, process->jobNode);
+	mm_free(process->jobNode);
+	process->job = NULL;
+	process->jobNode = NULL;
+	if (isEmpty(job->members)) {
+		freeLinkedListADT(job->members);
+		mm_free(job);
+	}
 }
 
-void killForegroundProcess() {
-	SchedulerADT scheduler = getSchedulerADT();
-	scheduler->killFgProcess = 1;
+int8_t processesShareJob(uint16_t pid, uint16_t other) {
+	Process *process = getProcess(pid);
+	Process *otherProcess = getProcess(other);
+	return process != NULL && otherProcess != NULL && process->job != NULL && process->job == otherProcess->job;
+}
+
+// Llamado desde el handler diferido del teclado, que corre en kworker: ningún miembro del
+// trabajo está corriendo, así que todos mueren en el acto. Matar a uno lo saca de la
+// lista (y al último, libera el trabajo), por eso se guarda el siguiente antes
+void killForegroundProcess(int32_t pid) {
+	Process *focused = pid >= 0 ? getProcess((uint16_t) pid) : NULL;
+	if (focused == NULL || focused->job == NULL)
+		return;
+
+	Job *job = focused->job;
+	uint8_t killed = 0;
+	Node *node = getFirst(job->members);
+	while (node != NULL) {
+		Process *member = (Process *) node->data;
+		Node *nextNode = node->next;
+		if (killProcess(member->pid, -1) != -1)
+			killed = 1;
+		node = nextNode;
+	}
+	if (killed)
+		print("Killing foreground process\n");
 }
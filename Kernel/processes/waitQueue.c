@@ -0,0 +1,83 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <linkedListADT.h>
+#include <processes.h>
+#include <scheduler.h>
+#include <stdint.h>
+#include <wait_queue.h>
+
+static void unlinkWaiter(Process *p) {
+	removeNode((WaitQueueADT) p->waitQueue, &p->waitNode);
+	p->waitQueue = NULL;
+	p->waitChannel = NULL;
+}
+
+static int16_t wake(Process *p) {
+	unlinkWaiter(p);
+	setStatus(p->pid, READY);
+	return p->pid;
+}
+
+WaitQueueADT createWaitQueue() {
+	return createLinkedListADT();
+}
+
+void freeWaitQueue(WaitQueueADT queue) {
+	waitQueueWakeAll(queue);
+	freeLinkedListADT(queue);
+}
+
+void waitQueueSleep(WaitQueueADT queue) {
+	waitQueueSleepOn(queue, NULL);
+}
+
+void waitQueueSleepOn(WaitQueueADT queue, const void *channel) {
+	Process *p = getCurrentProcess();
+	p->waitNode.data = p;
+	p->waitQueue = queue;
+	p->waitChannel = channel;
+	appendNode(queue, &p->waitNode);
+	setStatus(p->pid, BLOCKED);
+	yield();
+	// Si lo desbloquearon por otro camino (unblock) sigue encolado
+	if (p->waitQueue != NULL)
+		unlinkWaiter(p);
+}
+
+int16_t waitQueueWakeOne(WaitQueueADT queue) {
+	Node *first = getFirst(queue);
+	if (first == NULL)
+		return -1;
+	return wake((Process *) first->data);
+}
+
+int16_t waitQueueWakeChannel(WaitQueueADT queue, const void *channel) {
+	for (Node *node = getFirst(queue); node != NULL; node = node->next) {
+		Process *p = (Process *) node->data;
+		if (p->waitChannel == channel)
+			return wake(p);
+	}
+	return -1;
+}
+
+uint16_t waitQueueWakeAll(WaitQueueADT queue) {
+	uint16_t woken = 0;
+	while (waitQueueWakeOne(queue) != -1)
+		woken++;
+	return woken;
+}
+
+int8_t waitQueueHighestPriority(WaitQueueADT queue) {
+	int8_t highest = -1;
+	for (Node *node = getFirst(queue); node != NULL; node = node->next) {
+		Process *p = (Process *) node->data;
+		if ((int8_t) p->priority > highest)
+			highest = p->priority;
+	}
+	return highest;
+}
+
+void waitQueueRemove(Process *p) {
+	if (p != NULL && p->waitQueue != NULL)
+		unlinkWaiter(p);
+}
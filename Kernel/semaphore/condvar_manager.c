@@ -0,0 +1,100 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <condvar_manager.h>
+#include <defs.h>
+#include <interrupts.h>
+#include <memory_manager.h>
+#include <mutex_manager.h>
+#include <stdint.h>
+#include <wait_queue.h>
+
+// Variables de condición asociadas a los mutex del kernel. Soltar el mutex y
+// dormir ocurre con las interrupciones enmascaradas, así que una señal no se
+// puede perder entre las dos cosas.
+typedef struct CondVar {
+	WaitQueueADT waitQueue;
+} CondVar;
+
+typedef struct CondVarManagerCDT {
+	CondVar *condVars[MAX_CONDVARS];
+	uint16_t qtyCondVars;
+} CondVarManagerCDT;
+
+static CondVarManagerADT getCondVarManager() {
+	return (CondVarManagerADT) CONDVAR_MANAGER_ADDRESS;
+}
+
+static CondVar *getCondVar(uint16_t id) {
+	if (id >= MAX_CONDVARS)
+		return NULL;
+	return getCondVarManager()->condVars[id];
+}
+
+CondVarManagerADT createCondVarManager() {
+	CondVarManagerADT manager = (CondVarManagerADT) CONDVAR_MANAGER_ADDRESS;
+	for (int i = 0; i < MAX_CONDVARS; i++)
+		manager->condVars[i] = NULL;
+	manager->qtyCondVars = 0;
+	return manager;
+}
+
+int16_t condCreate() {
+	CondVarManagerADT manager = getCondVarManager();
+	if (manager->qtyCondVars >= MAX_CONDVARS)
+		return -1;
+	CondVar *condVar = (CondVar *) mm_malloc(sizeof(CondVar));
+	if (condVar == NULL)
+		return -1;
+	condVar->waitQueue = createWaitQueue();
+
+	int16_t id = 0;
+	while (manager->condVars[id] != NULL)
+		id++;
+	manager->condVars[id] = condVar;
+	manager->qtyCondVars++;
+	return id;
+}
+
+int8_t condWait(uint16_t id, uint16_t mutexId) {
+	CondVar *condVar = getCondVar(id);
+	if (condVar == NULL)
+		return -1;
+
+	uint64_t flags = _cliSave();
+	if (mutexRelease(mutexId) == -1) {
+		_restoreFlags(flags);
+		return -1;
+	}
+	waitQueueSleep(condVar->waitQueue);
+	_restoreFlags(flags);
+	return mutexLock(mutexId);
+}
+
+// No cede la CPU: quien señala suele tener el mutex, y el despertado se bloquearía en él
+int8_t condSignal(uint16_t id) {
+	CondVar *condVar = getCondVar(id);
+	if (condVar == NULL)
+		return -1;
+	waitQueueWakeOne(condVar->waitQueue);
+	return 0;
+}
+
+int8_t condBroadcast(uint16_t id) {
+	CondVar *condVar = getCondVar(id);
+	if (condVar == NULL)
+		return -1;
+	waitQueueWakeAll(condVar->waitQueue);
+	return 0;
+}
+
+int8_t condDestroy(uint16_t id) {
+	CondVar *condVar = getCondVar(id);
+	if (condVar == NULL || isEmpty(condVar->waitQueue) == 0)
+		return -1;
+	CondVarManagerADT manager = getCondVarManager();
+	manager->condVars[id] = NULL;
+	manager->qtyCondVars--;
+	freeWaitQueue(condVar->waitQueue);
+	mm_free(condVar);
+	return 0;
+}
@@ -0,0 +1,46 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <defs.h>
+#include <futex.h>
+#include <stdint.h>
+#include <wait_queue.h>
+
+// El contador vive en memoria de usuario y se modifica con lock xadd/cmpxchg.
+// El kernel solo interviene cuando hay contención: guarda a los procesos
+// dormidos en una tabla de hash indexada por la dirección del contador.
+#define bucketOf(address) ((((uint64_t) (address)) >> 2) % FUTEX_BUCKETS)
+
+typedef struct FutexManagerCDT {
+	WaitQueueADT buckets[FUTEX_BUCKETS];
+} FutexManagerCDT;
+
+static FutexManagerADT getFutexManager() {
+	return (FutexManagerADT) FUTEX_MANAGER_ADDRESS;
+}
+
+FutexManagerADT createFutexManager() {
+	FutexManagerADT manager = (FutexManagerADT) FUTEX_MANAGER_ADDRESS;
+	for (int i = 0; i < FUTEX_BUCKETS; i++)
+		manager->buckets[i] = createWaitQueue();
+	return manager;
+}
+
+int8_t futexWait(volatile int32_t *address, int32_t expected) {
+	if (address == NULL || ((uint64_t) address & 3) != 0)
+		return -1;
+	// Las syscalls corren con interrupciones deshabilitadas: comparar y dormir es atómico
+	if (*address != expected)
+		return -1;
+	waitQueueSleepOn(getFutexManager()->buckets[bucketOf(address)], (const void *) address);
+	return 0;
+}
+
+int32_t futexWake(volatile int32_t *address, uint32_t count) {
+	if (address == NULL)
+		return -1;
+	WaitQueueADT bucket = getFutexManager()->buckets[bucketOf(address)];
+	int32_t woken = 0;
+	while ((uint32_t) woken < count && waitQueueWakeChannel(bucket, (const void *) address) != -1)
+		woken++;
+	return woken;
+}
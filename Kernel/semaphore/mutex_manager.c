@@ -0,0 +1,152 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <defs.h>
+#include <interrupts.h>
+#include <memory_manager.h>
+#include <mutex_manager.h>
+#include <processes.h>
+#include <scheduler.h>
+#include <stdint.h>
+#include <wait_queue.h>
+
+// Mutex con dueño y herencia de prioridad: mientras alguien espera, el dueño
+// corre al menos con la prioridad del que espera, así el MLFQ no lo relega
+// detrás de procesos de prioridad intermedia.
+typedef struct Mutex {
+	int16_t owner;
+	WaitQueueADT waitQueue;
+} Mutex;
+
+typedef struct MutexManagerCDT {
+	Mutex *mutexes[MAX_MUTEXES];
+	uint16_t qtyMutexes;
+} MutexManagerCDT;
+
+static void handOff(Mutex *mutex);
+static void boostOwner(Mutex *mutex);
+static void restoreOwnerPriority(uint16_t pid);
+
+static MutexManagerADT getMutexManager() {
+	return (MutexManagerADT) MUTEX_MANAGER_ADDRESS;
+}
+
+static Mutex *getMutex(uint16_t id) {
+	if (id >= MAX_MUTEXES)
+		return NULL;
+	return getMutexManager()->mutexes[id];
+}
+
+MutexManagerADT createMutexManager() {
+	MutexManagerADT manager = (MutexManagerADT) MUTEX_MANAGER_ADDRESS;
+	for (int i = 0; i < MAX_MUTEXES; i++)
+		manager->mutexes[i] = NULL;
+	manager->qtyMutexes = 0;
+	return manager;
+}
+
+int16_t mutexCreate() {
+	MutexManagerADT manager = getMutexManager();
+	if (manager->qtyMutexes >= MAX_MUTEXES)
+		return -1;
+	Mutex *mutex = (Mutex *) mm_malloc(sizeof(Mutex));
+	if (mutex == NULL)
+		return -1;
+	mutex->owner = NO_OWNER;
+	mutex->waitQueue = createWaitQueue();
+
+	int16_t id = 0;
+	while (manager->mutexes[id] != NULL)
+		id++;
+	manager->mutexes[id] = mutex;
+	manager->qtyMutexes++;
+	return id;
+}
+
+int8_t mutexLock(uint16_t id) {
+	Mutex *mutex = getMutex(id);
+	int16_t pid = getpid();
+	if (mutex == NULL || mutex->owner == pid)
+		return -1;
+
+	uint64_t flags = _cliSave();
+	while (mutex->owner != NO_OWNER && mutex->owner != pid) {
+		Process *current = getCurrentProcess();
+		inheritPriority(mutex->owner, current->priority);
+		waitQueueSleep(mutex->waitQueue);
+		if (getMutex(id) != mutex) { // Lo destruyeron mientras esperábamos
+			_restoreFlags(flags);
+			return -1;
+		}
+	}
+	mutex->owner = pid; // Sin contención, o nos lo pasó el dueño anterior
+	_restoreFlags(flags);
+	return 0;
+}
+
+int8_t mutexUnlock(uint16_t id) {
+	Mutex *mutex = getMutex(id);
+	if (mutexRelease(id) == -1)
+		return -1;
+	if (mutex->owner != NO_OWNER)
+		yield();
+	return 0;
+}
+
+int8_t mutexRelease(uint16_t id) {
+	Mutex *mutex = getMutex(id);
+	if (mutex == NULL || mutex->owner != getpid())
+		return -1;
+	uint64_t flags = _cliSave();
+	handOff(mutex);
+	_restoreFlags(flags);
+	return 0;
+}
+
+int8_t mutexDestroy(uint16_t id) {
+	Mutex *mutex = getMutex(id);
+	if (mutex == NULL || mutex->owner != NO_OWNER || isEmpty(mutex->waitQueue) == 0)
+		return -1;
+	MutexManagerADT manager = getMutexManager();
+	manager->mutexes[id] = NULL;
+	manager->qtyMutexes--;
+	freeWaitQueue(mutex->waitQueue);
+	mm_free(mutex);
+	return 0;
+}
+
+void mutexReleaseAllForPid(uint16_t pid) {
+	MutexManagerADT manager = getMutexManager();
+	for (int i = 0; i < MAX_MUTEXES; i++)
+		if (manager->mutexes[i] != NULL && manager->mutexes[i]->owner == pid)
+			handOff(manager->mutexes[i]);
+}
+
+// Pasa el mutex al primero que espera (o lo deja libre) y recalcula la prioridad del dueño anterior
+static void handOff(Mutex *mutex) {
+	uint16_t previousOwner = mutex->owner;
+	mutex->owner = waitQueueWakeOne(mutex->waitQueue);
+	restoreOwnerPriority(previousOwner);
+	if (mutex->owner != NO_OWNER)
+		boostOwner(mutex);
+}
+
+static void boostOwner(Mutex *mutex) {
+	int8_t highest = waitQueueHighestPriority(mutex->waitQueue);
+	if (highest != -1)
+		inheritPriority(mutex->owner, highest);
+}
+
+// El dueño conserva la herencia que le den los mutex que todavía tiene tomados
+static void restoreOwnerPriority(uint16_t pid) {
+	MutexManagerADT manager = getMutexManager();
+	int8_t inherited = -1;
+	for (int i = 0; i < MAX_MUTEXES; i++) {
+		Mutex *mutex = manager->mutexes[i];
+		if (mutex != NULL && mutex->owner == pid) {
+			int8_t highest = waitQueueHighestPriority(mutex->waitQueue);
+			if (highest > inherited)
+				inherited = highest;
+		}
+	}
+	restorePriority(pid, inherited);
+}
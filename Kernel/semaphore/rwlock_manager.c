@@ -0,0 +1,182 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <defs.h>
+#include <interrupts.h>
+#include <linkedListADT.h>
+#include <memory_manager.h>
+#include <mutex_manager.h>
+#include <rwlock_manager.h>
+#include <scheduler.h>
+#include <stdint.h>
+#include <wait_queue.h>
+
+#define pidToData(pid) ((void *) ((uint64_t) (pid)))
+
+// Locks de lectura/escritura con preferencia de escritores: si hay un escritor
+// esperando, los lectores nuevos esperan. El lock se entrega directamente al
+// que se despierta (escritor, o todos los lectores juntos).
+typedef struct RWLock {
+	int16_t writer;			  // pid del escritor, NO_OWNER si no hay
+	LinkedListADT readers;	  // pids con el lock de lectura, uno por lock
+	WaitQueueADT writersQueue;
+	WaitQueueADT readersQueue;
+} RWLock;
+
+typedef struct RWLockManagerCDT {
+	RWLock *locks[MAX_RWLOCKS];
+	uint16_t qtyLocks;
+} RWLockManagerCDT;
+
+static void releaseWriter(RWLock *lock);
+static int8_t releaseReader(RWLock *lock, uint16_t pid);
+
+static RWLockManagerADT getRWLockManager() {
+	return (RWLockManagerADT) RWLOCK_MANAGER_ADDRESS;
+}
+
+static RWLock *getRWLock(uint16_t id) {
+	if (id >= MAX_RWLOCKS)
+		return NULL;
+	return getRWLockManager()->locks[id];
+}
+
+RWLockManagerADT createRWLockManager() {
+	RWLockManagerADT manager = (RWLockManagerADT) RWLOCK_MANAGER_ADDRESS;
+	for (int i = 0; i < MAX_RWLOCKS; i++)
+		manager->locks[i] = NULL;
+	manager->qtyLocks = 0;
+	return manager;
+}
+
+int16_t rwlockCreate() {
+	RWLockManagerADT manager = getRWLockManager();
+	if (manager->qtyLocks >= MAX_RWLOCKS)
+		return -1;
+	RWLock *lock = (RWLock *) mm_malloc(sizeof(RWLock));
+	if (lock == NULL)
+		return -1;
+	lock->writer = NO_OWNER;
+	lock->readers = createLinkedListADT();
+	lock->writersQueue = createWaitQueue();
+	lock->readersQueue = createWaitQueue();
+
+	int16_t id = 0;
+	while (manager->locks[id] != NULL)
+		id++;
+	manager->locks[id] = lock;
+	manager->qtyLocks++;
+	return id;
+}
+
+int8_t rwlockReadLock(uint16_t id) {
+	RWLock *lock = getRWLock(id);
+	if (lock == NULL)
+		return -1;
+
+	uint64_t flags = _cliSave();
+	while (lock->writer != NO_OWNER || isEmpty(lock->writersQueue) == 0) {
+		waitQueueSleep(lock->readersQueue);
+		if (getRWLock(id) != lock) {
+			_restoreFlags(flags);
+			return -1;
+		}
+		// releaseWriter ya nos anotó como lectores al despertarnos
+		for (Node *node = getFirst(lock->readers); node != NULL; node = node->next)
+			if (node->data == pidToData(getpid())) {
+				_restoreFlags(flags);
+				return 0;
+			}
+	}
+	int8_t ret = appendElement(lock->readers, pidToData(getpid())) == NULL ? -1 : 0;
+	_restoreFlags(flags);
+	return ret;
+}
+
+int8_t rwlockReadUnlock(uint16_t id) {
+	RWLock *lock = getRWLock(id);
+	if (lock == NULL)
+		return -1;
+	uint64_t flags = _cliSave();
+	int8_t ret = releaseReader(lock, getpid());
+	_restoreFlags(flags);
+	return ret;
+}
+
+int8_t rwlockWriteLock(uint16_t id) {
+	RWLock *lock = getRWLock(id);
+	int16_t pid = getpid();
+	if (lock == NULL || lock->writer == pid)
+		return -1;
+
+	uint64_t flags = _cliSave();
+	while (lock->writer != pid && (lock->writer != NO_OWNER || isEmpty(lock->readers) == 0)) {
+		waitQueueSleep(lock->writersQueue);
+		if (getRWLock(id) != lock) {
+			_restoreFlags(flags);
+			return -1;
+		}
+	}
+	lock->writer = pid;
+	_restoreFlags(flags);
+	return 0;
+}
+
+int8_t rwlockWriteUnlock(uint16_t id) {
+	RWLock *lock = getRWLock(id);
+	if (lock == NULL || lock->writer != getpid())
+		return -1;
+	uint64_t flags = _cliSave();
+	releaseWriter(lock);
+	_restoreFlags(flags);
+	return 0;
+}
+
+int8_t rwlockDestroy(uint16_t id) {
+	RWLock *lock = getRWLock(id);
+	if (lock == NULL || lock->writer != NO_OWNER || isEmpty(lock->readers) == 0 ||
+		isEmpty(lock->writersQueue) == 0 || isEmpty(lock->readersQueue) == 0)
+		return -1;
+	RWLockManagerADT manager = getRWLockManager();
+	manager->locks[id] = NULL;
+	manager->qtyLocks--;
+	freeWaitQueue(lock->writersQueue);
+	freeWaitQueue(lock->readersQueue);
+	freeLinkedListADTDeep(lock->readers);
+	mm_free(lock);
+	return 0;
+}
+
+void rwlockReleaseAllForPid(uint16_t pid) {
+	RWLockManagerADT manager = getRWLockManager();
+	for (int i = 0; i < MAX_RWLOCKS; i++) {
+		RWLock *lock = manager->locks[i];
+		if (lock == NULL)
+			continue;
+		if (lock->writer == pid)
+			releaseWriter(lock);
+		while (releaseReader(lock, pid) == 0);
+	}
+}
+
+// Prioridad a los escritores; si no hay ninguno esperando, entran todos los lectores
+static void releaseWriter(RWLock *lock) {
+	lock->writer = waitQueueWakeOne(lock->writersQueue);
+	if (lock->writer != NO_OWNER)
+		return;
+	int16_t pid;
+	while ((pid = waitQueueWakeOne(lock->readersQueue)) != -1)
+		appendElement(lock->readers, pidToData(pid));
+}
+
+static int8_t releaseReader(RWLock *lock, uint16_t pid) {
+	for (Node *node = getFirst(lock->readers); node != NULL; node = node->next) {
+		if (node->data == pidToData(pid)) {
+			removeNode(lock->readers, node);
+			mm_free(node);
+			if (isEmpty(lock->readers))
+				lock->writer = waitQueueWakeOne(lock->writersQueue);
+			return 0;
+		}
+	}
+	return -1;
+}
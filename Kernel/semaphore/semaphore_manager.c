@@ -1,6 +1,7 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include <defs.h>
+#include <interrupts.h>
 #include <lib.h>
 #include <linkedListADT.h>
 #include <memory_manager.h>
@@ -9,33 +10,50 @@
 #include <semaphore_manager.h>
 #include <stdint.h>
 #include <stdlib.h>
-#include <lib.h>
+#include <wait_queue.h>
 
-#define MAX_SEMAPHORES (1 << 12)
+#define SEM_HASH_BUCKETS 64
+#define pidToData(pid) ((void *) ((uint64_t) (pid)))
 
+// Las operaciones corren en un único procesador con las interrupciones
+// enmascaradas, así que no hace falta un mutex propio por semáforo.
 typedef struct Semaphore {
+	uint16_t id;
+	uint32_t generation; // distinta para cada semáforo creado, aunque reuse el id
+	char *name; // NULL para los semáforos numéricos
 	uint32_t value;
-	uint64_t mutex;				  // 0 libre, 1 ocupado (64-bit, matches _xchg)
-	LinkedListADT semaphoreQueue; // LinkedListADT de pids
-	LinkedListADT mutexQueue;	  // LinkedListADT de pids
+	uint16_t references;		// solo semáforos con nombre
+	LinkedListADT holders;		// pids que lo abrieron por nombre, uno por apertura
+	WaitQueueADT waitQueue;		// PCBs bloqueados, sin memoria extra por espera
+	struct Semaphore *nextById; // encadenamiento en la tabla de hash
+	struct Semaphore *nextByName;
 } Semaphore;
 
-static Semaphore *createSemaphore(uint32_t initialValue);
+static Semaphore *createSemaphore(uint16_t id, const char *name, uint32_t initialValue);
+static void unregisterSemaphore(Semaphore *sem);
 static void freeSemaphore(Semaphore *sem);
-static void acquireMutex(Semaphore *sem);
-static void resumeFirstAvailableProcess(LinkedListADT queue);
-static void releaseMutex(Semaphore *sem);
 static int up(Semaphore *sem);
-static int down(Semaphore *sem);
+static int down(uint16_t id, Semaphore *sem);
 
+// Registro bajo demanda: solo existen los semáforos creados, encadenados por id
+// y, los que tienen nombre, también por nombre
 typedef struct SemaphoreManagerCDT {
-	Semaphore *semaphores[MAX_SEMAPHORES];
+	Semaphore *byId[SEM_HASH_BUCKETS];
+	Semaphore *byName[SEM_HASH_BUCKETS];
+	uint16_t nextNamedId;
+	uint16_t qtyNamed;
+	uint32_t nextGeneration;
 } SemaphoreManagerCDT;
 
 SemaphoreManagerADT createSemaphoreManager() {
 	SemaphoreManagerADT semManager = (SemaphoreManagerADT) SEMAPHORE_MANAGER_ADDRESS;
-	for (int i = 0; i < MAX_SEMAPHORES; i++)
-		semManager->semaphores[i] = NULL;
+	for (int i = 0; i < SEM_HASH_BUCKETS; i++) {
+		semManager->byId[i] = NULL;
+		semManager->byName[i] = NULL;
+	}
+	semManager->nextNamedId = FIRST_NAMED_SEM_ID;
+	semManager->qtyNamed = 0;
+	semManager->nextGeneration = 0;
 	return semManager;
 }
 
@@ -43,121 +61,214 @@ static SemaphoreManagerADT getSemaphoreManager() {
 	return (SemaphoreManagerADT) SEMAPHORE_MANAGER_ADDRESS;
 }
 
-int8_t semInit(uint16_t id, uint32_t initialValue) {
-	SemaphoreManagerADT semManager = getSemaphoreManager();
-	if (semManager->semaphores[id] != NULL)
+static uint16_t hashName(const char *name) {
+	uint32_t hash = 5381; // djb2
+	while (*name != 0)
+		hash = hash * 33 + (uint8_t) *name++;
+	return hash % SEM_HASH_BUCKETS;
+}
+
+static Semaphore *getSemaphore(uint16_t id) {
+	Semaphore *sem = getSemaphoreManager()->byId[id % SEM_HASH_BUCKETS];
+	while (sem != NULL && sem->id != id)
+		sem = sem->nextById;
+	return sem;
+}
+
+static Semaphore *getSemaphoreByName(const char *name) {
+	Semaphore *sem = getSemaphoreManager()->byName[hashName(name)];
+	while (sem != NULL && strcmp(sem->name, name) != 0)
+		sem = sem->nextByName;
+	return sem;
+}
+
+static int8_t registerSemaphore(Semaphore *sem) {
+	if (sem == NULL)
 		return -1;
-	semManager->semaphores[id] = createSemaphore(initialValue);
+	SemaphoreManagerADT semManager = getSemaphoreManager();
+	Semaphore **bucket = &semManager->byId[sem->id % SEM_HASH_BUCKETS];
+	sem->nextById = *bucket;
+	*bucket = sem;
+	if (sem->name != NULL) {
+		bucket = &semManager->byName[hashName(sem->name)];
+		sem->nextByName = *bucket;
+		*bucket = sem;
+		semManager->qtyNamed++;
+	}
 	return 0;
 }
 
+int8_t semInit(uint16_t id, uint32_t initialValue) {
+	if (id >= FIRST_NAMED_SEM_ID || getSemaphore(id) != NULL)
+		return -1;
+	return registerSemaphore(createSemaphore(id, NULL, initialValue));
+}
+
 int8_t semOpen(uint16_t id) {
-	SemaphoreManagerADT semManager = getSemaphoreManager();
-	return semManager->semaphores[id] == NULL ? -1 : 0;
+	return getSemaphore(id) == NULL ? -1 : 0;
+}
+
+int32_t semOpenNamed(const char *name, uint32_t initialValue) {
+	if (name == NULL || strlen(name) == 0 || strlen(name) >= SEM_NAME_MAX)
+		return -1;
+	Semaphore *sem = getSemaphoreByName(name);
+	if (sem == NULL) {
+		SemaphoreManagerADT semManager = getSemaphoreManager();
+		if (semManager->qtyNamed >= MAX_SEMAPHORE_ID - FIRST_NAMED_SEM_ID + 1)
+			return -1;
+		while (getSemaphore(semManager->nextNamedId) != NULL)
+			semManager->nextNamedId = semManager->nextNamedId == MAX_SEMAPHORE_ID ? FIRST_NAMED_SEM_ID : semManager->nextNamedId + 1;
+		sem = createSemaphore(semManager->nextNamedId, name, initialValue);
+		if (registerSemaphore(sem) == -1)
+			return -1;
+	}
+	if (appendElement(sem->holders, pidToData(getpid())) == NULL)
+		return -1;
+	sem->references++;
+	return sem->id;
+}
+
+// Suelta una referencia de pid sobre un semáforo con nombre y lo destruye con la última.
+// Devuelve -1 si pid no lo tenía abierto, 1 si el semáforo se destruyó y 0 si no
+static int8_t releaseNamedReference(Semaphore *sem, uint16_t pid) {
+	for (Node *node = getFirst(sem->holders); node != NULL; node = node->next) {
+		if (node->data == pidToData(pid)) {
+			removeNode(sem->holders, node);
+			mm_free(node);
+			if (--sem->references == 0) {
+				unregisterSemaphore(sem);
+				freeSemaphore(sem);
+				return 1;
+			}
+			return 0;
+		}
+	}
+	return -1;
 }
 
 int8_t semClose(uint16_t id) {
-	SemaphoreManagerADT semManager = getSemaphoreManager();
-	if (semManager->semaphores[id] == NULL)
+	Semaphore *sem = getSemaphore(id);
+	if (sem == NULL)
 		return -1;
+	if (sem->name != NULL)
+		return releaseNamedReference(sem, getpid()) == -1 ? -1 : 0;
 
-	freeSemaphore(semManager->semaphores[id]);
-	semManager->semaphores[id] = NULL;
+	unregisterSemaphore(sem);
+	freeSemaphore(sem);
 	return 0;
 }
 
-int8_t semPost(uint16_t id) {
+void semCloseAllForPid(uint16_t pid) {
 	SemaphoreManagerADT semManager = getSemaphoreManager();
-	if (semManager->semaphores[id] == NULL)
+	for (int i = 0; i < SEM_HASH_BUCKETS && semManager->qtyNamed > 0; i++) {
+		Semaphore *sem = semManager->byName[i];
+		while (sem != NULL) {
+			Semaphore *nextSem = sem->nextByName;
+			while (releaseNamedReference(sem, pid) == 0);
+			sem = nextSem;
+		}
+	}
+}
+
+int8_t semPost(uint16_t id) {
+	Semaphore *sem = getSemaphore(id);
+	if (sem == NULL)
 		return -1;
-	return up(semManager->semaphores[id]);
+	return up(sem);
 }
 
 int8_t semWait(uint16_t id) {
-	SemaphoreManagerADT semManager = getSemaphoreManager();
-	if (semManager->semaphores[id] == NULL)
+	Semaphore *sem = getSemaphore(id);
+	if (sem == NULL)
 		return -1;
-	return down(semManager->semaphores[id]);
+	return down(id, sem);
 }
 
-static Semaphore *createSemaphore(uint32_t initialValue) {
+static Semaphore *createSemaphore(uint16_t id, const char *name, uint32_t initialValue) {
     Semaphore *sem = (Semaphore *) mm_malloc(sizeof(Semaphore));
+	if (sem == NULL)
+		return NULL;
+	sem->name = NULL;
+	if (name != NULL) {
+		sem->name = (char *) mm_malloc(strlen(name) + 1);
+		if (sem->name == NULL) {
+			mm_free(sem);
+			return NULL;
+		}
+		memcpy(sem->name, name, strlen(name) + 1);
+	}
+	sem->id = id;
+	sem->generation = getSemaphoreManager()->nextGeneration++;
 	sem->value = initialValue;
-	sem->mutex = 0;
-	sem->semaphoreQueue = createLinkedListADT();
-	sem->mutexQueue = createLinkedListADT();
+	sem->references = 0;
+	sem->holders = createLinkedListADT();
+	sem->waitQueue = createWaitQueue();
+	sem->nextById = NULL;
+	sem->nextByName = NULL;
 	return sem;
 }
 
-static void freeSemaphore(Semaphore *sem) {
-	freeLinkedListADTDeep(sem->semaphoreQueue);
-	freeLinkedListADTDeep(sem->mutexQueue);
-    mm_free(sem);
-}
-
-static void acquireMutex(Semaphore *sem) {
-    while (_xchg((volatile uint64_t *)&(sem->mutex), 1)) {
-		uint16_t pid = getpid();
-		appendElement(sem->mutexQueue, (void *) ((uint64_t) pid));
-		setStatus(pid, BLOCKED);
-		yield();
-	}
-}
-
-static void resumeFirstAvailableProcess(LinkedListADT queue) {
-    Node *current;
-	while ((current = getFirst(queue)) != NULL) {
-		removeNode(queue, current);
-		uint16_t pid = (uint16_t) ((uint64_t) current->data);
-        mm_free(current);
-		if (processIsAlive(pid)) {
-			setStatus(pid, READY);
-			break;
-		}
+static void unregisterSemaphore(Semaphore *sem) {
+	SemaphoreManagerADT semManager = getSemaphoreManager();
+	Semaphore **link = &semManager->byId[sem->id % SEM_HASH_BUCKETS];
+	while (*link != sem)
+		link = &(*link)->nextById;
+	*link = sem->nextById;
+	if (sem->name != NULL) {
+		link = &semManager->byName[hashName(sem->name)];
+		while (*link != sem)
+			link = &(*link)->nextByName;
+		*link = sem->nextByName;
+		semManager->qtyNamed--;
 	}
 }
 
-static void releaseMutex(Semaphore *sem) {
-	resumeFirstAvailableProcess(sem->mutexQueue);
-	sem->mutex = 0;
+// Los procesos que seguían esperando se despiertan y ven que el semáforo ya no existe
+static void freeSemaphore(Semaphore *sem) {
+	freeWaitQueue(sem->waitQueue);
+	freeLinkedListADTDeep(sem->holders);
+	mm_free(sem->name);
+    mm_free(sem);
 }
 
 static int up(Semaphore *sem) {
-	acquireMutex(sem);
+	uint64_t flags = _cliSave();
 	sem->value++;
-	// Si hay procesos esperando por el semáforo, reanudar uno
-	resumeFirstAvailableProcess(sem->semaphoreQueue);
-	releaseMutex(sem);
-	yield();
+	// Si hay procesos esperando por el semáforo, reanudar uno y cederle la CPU.
+	// Sin contención no hace falta forzar un cambio de contexto.
+	int16_t resumed = waitQueueWakeOne(sem->waitQueue);
+	_restoreFlags(flags);
+	if (resumed != -1)
+		yield();
 	return 0;
 }
 
-static int down(Semaphore *sem) {
-	acquireMutex(sem);
+// Al despertar se vuelve a buscar por id: si lo cerraron mientras esperábamos, sem
+// puede estar liberado y su memoria reusada por otro semáforo con el mismo id
+static int down(uint16_t id, Semaphore *sem) {
+	uint64_t flags = _cliSave();
+	uint32_t generation = sem->generation;
 	while (sem->value == 0) {
-		uint16_t pid = getpid();
-		appendElement(sem->semaphoreQueue, (void *) ((uint64_t) pid));
-		setStatus(pid, BLOCKED);
-		releaseMutex(sem);
-		yield();
-
-		acquireMutex(sem);
+		waitQueueSleep(sem->waitQueue);
+		sem = getSemaphore(id);
+		if (sem == NULL || sem->generation != generation) {
+			_restoreFlags(flags);
+			return -1;
+		}
 	}
 	sem->value--;
-	releaseMutex(sem);
-
+	_restoreFlags(flags);
 	return 0;
 }
 
 int8_t semDestroy(uint16_t id) {
-	SemaphoreManagerADT semManager = getSemaphoreManager();
-	if (semManager->semaphores[id] == NULL)
+	Semaphore *sem = getSemaphore(id);
+	if (sem == NULL)
 		return -1;
-	Semaphore *sem = semManager->semaphores[id];
-	if (isEmpty(sem->semaphoreQueue) == 0 || isEmpty(sem->mutexQueue) == 0) {
+	if (isEmpty(sem->waitQueue) == 0) {
 		return -1; // still in use
 	}
+	unregisterSemaphore(sem);
 	freeSemaphore(sem);
-	semManager->semaphores[id] = NULL;
 	return 0;
 }
@@ -0,0 +1,154 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <defs.h>
+#include <lib.h>
+#include <linkedListADT.h>
+#include <memory_manager.h>
+#include <scheduler.h>
+#include <shm_manager.h>
+#include <stdint.h>
+
+#define pageAlign(value) (((uint64_t) (value) + SHM_PAGE_SIZE - 1) & ~((uint64_t) SHM_PAGE_SIZE - 1))
+#define pidToData(pid) ((void *) ((uint64_t) (pid)))
+
+typedef struct Segment {
+	uint32_t key;
+	uint64_t size;
+	void *rawAddress; // lo que devolvió mm_malloc
+	void *address;	  // rawAddress alineada a página
+	uint8_t destroyed;
+	LinkedListADT attachedPids; // un nodo por cada attach
+} Segment;
+
+typedef struct ShmManagerCDT {
+	Segment *segments[SHM_MAX_SEGMENTS];
+	uint16_t qtySegments;
+} ShmManagerCDT;
+
+static void releaseSegment(ShmManagerADT manager, int16_t index);
+static int8_t removeAttachment(Segment *segment, uint16_t pid);
+
+static ShmManagerADT getShmManager() {
+	return (ShmManagerADT) SHARED_MEMORY_MANAGER_ADDRESS;
+}
+
+static int16_t getSegmentIndexByKey(ShmManagerADT manager, uint32_t key) {
+	for (int16_t i = 0; i < SHM_MAX_SEGMENTS; i++)
+		if (manager->segments[i] != NULL && !manager->segments[i]->destroyed && manager->segments[i]->key == key)
+			return i;
+	return -1;
+}
+
+ShmManagerADT createShmManager() {
+	ShmManagerADT manager = (ShmManagerADT) SHARED_MEMORY_MANAGER_ADDRESS;
+	for (int i = 0; i < SHM_MAX_SEGMENTS; i++)
+		manager->segments[i] = NULL;
+	manager->qtySegments = 0;
+	return manager;
+}
+
+int8_t shmCreate(uint32_t key, uint64_t size) {
+	ShmManagerADT manager = getShmManager();
+	if (size == 0 || size > SHM_MAX_SIZE || manager->qtySegments >= SHM_MAX_SEGMENTS ||
+		getSegmentIndexByKey(manager, key) != -1)
+		return -1;
+
+	Segment *segment = (Segment *) mm_malloc(sizeof(Segment));
+	if (segment == NULL)
+		return -1;
+	segment->size = pageAlign(size);
+	segment->rawAddress = mm_malloc(segment->size + SHM_PAGE_SIZE - 1);
+	if (segment->rawAddress == NULL) {
+		mm_free(segment);
+		return -1;
+	}
+	segment->address = (void *) pageAlign(segment->rawAddress);
+	memset(segment->address, 0, segment->size);
+	segment->key = key;
+	segment->destroyed = 0;
+	segment->attachedPids = createLinkedListADT();
+	if (segment->attachedPids == NULL) {
+		mm_free(segment->rawAddress);
+		mm_free(segment);
+		return -1;
+	}
+
+	int16_t index = 0;
+	while (manager->segments[index] != NULL)
+		index++;
+	manager->segments[index] = segment;
+	manager->qtySegments++;
+	return 0;
+}
+
+void *shmAttach(uint32_t key) {
+	ShmManagerADT manager = getShmManager();
+	int16_t index = getSegmentIndexByKey(manager, key);
+	if (index == -1)
+		return NULL;
+	Segment *segment = manager->segments[index];
+	if (appendElement(segment->attachedPids, pidToData(getpid())) == NULL)
+		return NULL;
+	return segment->address;
+}
+
+int8_t shmDetach(void *address) {
+	ShmManagerADT manager = getShmManager();
+	for (int16_t i = 0; i < SHM_MAX_SEGMENTS; i++) {
+		Segment *segment = manager->segments[i];
+		if (segment == NULL || segment->address != address)
+			continue;
+		if (removeAttachment(segment, getpid()) == -1)
+			return -1;
+		if (isEmpty(segment->attachedPids))
+			releaseSegment(manager, i);
+		return 0;
+	}
+	return -1;
+}
+
+int8_t shmDestroy(uint32_t key) {
+	ShmManagerADT manager = getShmManager();
+	int16_t index = getSegmentIndexByKey(manager, key);
+	if (index == -1)
+		return -1;
+	Segment *segment = manager->segments[index];
+	segment->destroyed = 1;
+	if (isEmpty(segment->attachedPids))
+		releaseSegment(manager, index);
+	return 0;
+}
+
+void shmDetachAll(uint16_t pid) {
+	ShmManagerADT manager = getShmManager();
+	for (int16_t i = 0; i < SHM_MAX_SEGMENTS && manager->qtySegments > 0; i++) {
+		Segment *segment = manager->segments[i];
+		if (segment == NULL)
+			continue;
+		uint8_t detached = 0;
+		while (removeAttachment(segment, pid) == 0)
+			detached = 1;
+		if (detached && isEmpty(segment->attachedPids))
+			releaseSegment(manager, i);
+	}
+}
+
+static int8_t removeAttachment(Segment *segment, uint16_t pid) {
+	for (Node *node = getFirst(segment->attachedPids); node != NULL; node = node->next) {
+		if (node->data == pidToData(pid)) {
+			removeNode(segment->attachedPids, node);
+			mm_free(node);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+static void releaseSegment(ShmManagerADT manager, int16_t index) {
+	Segment *segment = manager->segments[index];
+	manager->segments[index] = NULL;
+	manager->qtySegments--;
+	freeLinkedListADTDeep(segment->attachedPids);
+	mm_free(segment->rawAddress);
+	mm_free(segment);
+}
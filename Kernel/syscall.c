@@ -2,10 +2,17 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 #include <stdint.h>
+#include <defs.h>
 #include <processes.h>
 #include <scheduler.h>
 #include <semaphore_manager.h>
-#include <pipe_manager.h>
+#include <futex.h>
+#include <mutex_manager.h>
+#include <condvar_manager.h>
+#include <rwlock_manager.h>
+#include <file_descriptors.h>
+#include <mqueue_manager.h>
+#include <shm_manager.h>
 #include <memory_manager.h>
 #include <lib.h>
 #include <fonts.h>
@@ -132,6 +139,18 @@ int64_t my_sem_destroy(uint16_t sem_id) {
   return semDestroy(sem_id);
 }
 
+int64_t my_sem_open_named(const char *name, uint64_t initialValue) {
+  return semOpenNamed(name, (uint32_t)initialValue);
+}
+
+int64_t my_futex_wait(volatile int32_t *address, int32_t expected) {
+  return futexWait(address, expected);
+}
+
+int64_t my_futex_wake(volatile int32_t *address, uint32_t count) {
+  return futexWake(address, count);
+}
+
 int64_t my_yield() {
   sched_yield();
   return 0;
@@ -251,6 +270,145 @@ int64_t my_print_ps(void) {
   return 0;
 }
 
-int64_t my_pipe_get(void) {
-  return getLastFreePipe();
+int64_t my_pipe(int16_t fds[2]) {
+  if (fds == NULL)
+    return -1;
+  return fdPipe(getCurrentProcess(), fds);
+}
+
+int64_t my_dup(int16_t fd) {
+  return fdDup(getCurrentProcess(), fd);
+}
+
+int64_t my_dup2(int16_t fd, int16_t newFd) {
+  return fdDup2(getCurrentProcess(), fd, newFd);
+}
+
+int64_t my_close(int16_t fd) {
+  return fdClose(getCurrentProcess(), fd);
+}
+
+int64_t my_mq_create(const char *name, uint16_t maxMessages, uint16_t messageSize) {
+  return mqCreate(name, maxMessages, messageSize);
+}
+
+int64_t my_mq_open(const char *name) {
+  return mqOpen(name);
+}
+
+int64_t my_mq_close(uint16_t id) {
+  return mqClose(id);
+}
+
+int64_t my_mq_send(uint16_t id, const void *message, uint16_t length, uint8_t priority, uint8_t flags) {
+  return mqSend(id, message, length, priority, flags);
+}
+
+int64_t my_mq_receive(uint16_t id, void *buffer, uint16_t length, uint8_t *priority, uint8_t flags) {
+  return mqReceive(id, buffer, length, priority, flags);
+}
+
+int64_t my_shm_create(uint32_t key, uint64_t size) {
+  return shmCreate(key, size);
+}
+
+void *my_shm_attach(uint32_t key) {
+  return shmAttach(key);
+}
+
+int64_t my_shm_detach(void *address) {
+  return shmDetach(address);
+}
+
+int64_t my_shm_destroy(uint32_t key) {
+  return shmDestroy(key);
+}
+
+int64_t my_mutex_create() {
+  return mutexCreate();
+}
+
+int64_t my_mutex_lock(uint16_t id) {
+  return mutexLock(id);
+}
+
+int64_t my_mutex_unlock(uint16_t id) {
+  return mutexUnlock(id);
+}
+
+int64_t my_mutex_destroy(uint16_t id) {
+  return mutexDestroy(id);
+}
+
+int64_t my_cond_create() {
+  return condCreate();
+}
+
+int64_t my_cond_wait(uint16_t id, uint16_t mutexId) {
+  return condWait(id, mutexId);
+}
+
+int64_t my_cond_signal(uint16_t id) {
+  return condSignal(id);
+}
+
+int64_t my_cond_broadcast(uint16_t id) {
+  return condBroadcast(id);
+}
+
+int64_t my_cond_destroy(uint16_t id) {
+  return condDestroy(id);
+}
+
+int64_t my_rwlock_create() {
+  return rwlockCreate();
+}
+
+int64_t my_rwlock_read_lock(uint16_t id) {
+  return rwlockReadLock(id);
+}
+
+int64_t my_rwlock_read_unlock(uint16_t id) {
+  return rwlockReadUnlock(id);
+}
+
+int64_t my_rwlock_write_lock(uint16_t id) {
+  return rwlockWriteLock(id);
+}
+
+int64_t my_rwlock_write_unlock(uint16_t id) {
+  return rwlockWriteUnlock(id);
+}
+
+int64_t my_rwlock_destroy(uint16_t id) {
+  return rwlockDestroy(id);
+}
+
+// Se reserva en el primer pedido; el scheduler publica el puntero del proceso en
+// ejecución en PROCESS_LOCAL_STORAGE_ADDRESS, así userland lo lee sin syscall
+void *my_local_storage() {
+  Process *p = getCurrentProcess();
+  if (p == NULL)
+    return NULL;
+  if (p->localStorage == NULL) {
+    p->localStorage = mm_malloc(PROCESS_LOCAL_STORAGE_SIZE);
+    if (p->localStorage == NULL)
+      return NULL;
+    memset(p->localStorage, 0, PROCESS_LOCAL_STORAGE_SIZE);
+    *((void **) PROCESS_LOCAL_STORAGE_ADDRESS) = p->localStorage;
+  }
+  return p->localStorage;
+}
+
+int64_t my_set_exit_hook(void (*hook)(void)) {
+  Process *p = getCurrentProcess();
+  if (p == NULL)
+    return -1;
+  p->exitHook = hook;
+  return 0;
+}
+
+int64_t my_isatty(int16_t fd) {
+  Process *p = getCurrentProcess();
+  return fdIsType(p, fd, CONSOLE_IN) || fdIsType(p, fd, CONSOLE_OUT) || fdIsType(p, fd, CONSOLE_ERR);
 }
@@ -12,16 +12,18 @@
 #define DEFAULT_READERS 2
 #define MAX_WRITERS 26
 
-#define MVAR_EMPTY_SEM_ID 3700
-#define MVAR_FULL_SEM_ID 3701
-#define MVAR_PRINT_SEM_ID 3702
-
 #define MVAR_PROCESS_PRIORITY 2
 #define MIN_DELAY_SPINS 225000u
 #define RANDOM_DELAY_SPINS 900000u
 
 static volatile char mvar_slot = 0;
 
+// Un mutex protege el slot y la impresión; los procesos esperan en dos
+// condiciones. Se crean con el primer mvar y se reutilizan en los siguientes
+static int16_t mvar_mutex = -1;
+static int16_t not_empty = -1;
+static int16_t not_full = -1;
+
 static const char *const reader_colors[] = {
     "\e[31m", "\e[32m", "\e[33m", "\e[34m", "\e[35m", "\e[36m", "\e[37m",
     "\e[90m", "\e[91m", "\e[92m", "\e[93m", "\e[94m", "\e[95m", "\e[96m",
@@ -40,8 +42,6 @@ static const char *const reader_formats[] = {
 
 #define MAX_READERS ((int)(sizeof(reader_colors) / sizeof(reader_colors[0])))
 
-static inline uint16_t sem_handle(uint16_t id) { return id; }
-
 static void random_delay(void) {
     uint32_t spins = MIN_DELAY_SPINS + GetUniform(RANDOM_DELAY_SPINS);
     bussy_wait(spins);
@@ -77,7 +77,7 @@ int cmd_mvar(int argc, char **argv) {
     }
 
     if (reset_mvar_sync() != 0) {
-        fprintf(FD_STDERR, "mvar: no se pudieron inicializar los semaforos\n");
+        fprintf(FD_STDERR, "mvar: no se pudieron inicializar el mutex y las condiciones\n");
         return 1;
     }
 
@@ -129,19 +129,14 @@ cleanup:
 }
 
 static int reset_mvar_sync(void) {
-    semDestroy(sem_handle(MVAR_EMPTY_SEM_ID));
-    semDestroy(sem_handle(MVAR_FULL_SEM_ID));
-    semDestroy(sem_handle(MVAR_PRINT_SEM_ID));
-
     mvar_slot = 0;
-
-    if (semOpen(sem_handle(MVAR_EMPTY_SEM_ID), 1) < 0) {
+    if (mvar_mutex < 0 && (mvar_mutex = mutexCreate()) < 0) {
         return -1;
     }
-    if (semOpen(sem_handle(MVAR_FULL_SEM_ID), 0) < 0) {
+    if (not_empty < 0 && (not_empty = condCreate()) < 0) {
         return -1;
     }
-    if (semOpen(sem_handle(MVAR_PRINT_SEM_ID), 1) < 0) {
+    if (not_full < 0 && (not_full = condCreate()) < 0) {
         return -1;
     }
     return 0;
@@ -157,9 +152,13 @@ static int writer_process(int argc, char **argv) {
 
     while (1) {
         random_delay();
-        semWait(sem_handle(MVAR_EMPTY_SEM_ID));
+        mutexLock(mvar_mutex);
+        while (mvar_slot != 0) {
+            condWait(not_full, mvar_mutex);
+        }
         mvar_slot = value;
-        semPost(sem_handle(MVAR_FULL_SEM_ID));
+        condSignal(not_empty);
+        mutexUnlock(mvar_mutex);
     }
     return 0;
 }
@@ -182,14 +181,16 @@ static int reader_process(int argc, char **argv) {
 
     while (1) {
         random_delay();
-        semWait(sem_handle(MVAR_FULL_SEM_ID));
+        mutexLock(mvar_mutex);
+        while (mvar_slot == 0) {
+            condWait(not_empty, mvar_mutex);
+        }
         char value = mvar_slot;
         mvar_slot = 0;
-        semPost(sem_handle(MVAR_EMPTY_SEM_ID));
-
-        semWait(sem_handle(MVAR_PRINT_SEM_ID));
+        condSignal(not_full);
         printf(print_format, value);
-        semPost(sem_handle(MVAR_PRINT_SEM_ID));
+        fflush(stdout); // no newline, so a line buffered stdout would hold it
+        mutexUnlock(mvar_mutex);
 
         yield();
     }
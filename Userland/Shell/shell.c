@@ -12,10 +12,6 @@
 #include <exceptions.h>
 #include <sys.h>
 
-#ifdef ANSI_4_BIT_COLOR_SUPPORT
-#include <ansiColors.h>
-#endif
-
 static const uintptr_t snakeModuleAddress = 0x500000;
 
 static inline int32_t execModule(uintptr_t address) {
@@ -27,6 +23,7 @@ static inline int32_t execModule(uintptr_t address) {
 #define HISTORY_SIZE 10
 #define MAX_ARGS 32
 #define DEFAULT_PRIORITY 4
+#define MAX_PIPELINE_STAGES 8
 #define STDIN 0
 #define STDOUT 1
 #define STDERR 2
@@ -70,11 +67,17 @@ int test_mm(int argc, char **argv);
 int test_processes(int argc, char **argv);
 int test_sync(int argc, char **argv);
 int test_prio(int argc, char **argv);
+int test_mq(int argc, char **argv);
+int test_rwlock(int argc, char **argv);
+int test_shm(int argc, char **argv);
+int test_pi(int argc, char **argv);
+int test_fb(int argc, char **argv);
 
 static void printPreviousCommand(enum REGISTERABLE_KEYS scancode);
 static void printNextCommand(enum REGISTERABLE_KEYS scancode);
 static uint8_t stripBackgroundMarker(void);
 static void saveCommandToHistory(uint8_t run_in_background);
+static int runPipeline(char *line, uint8_t run_in_background);
 
 static uint8_t last_command_arrowed = 0;
 
@@ -115,11 +118,26 @@ Command commands[] = {
          "Runs the processes test. Usage: test_processes [max_processes]"},
     {.name = "test_sync",
      .function = test_sync,
-     .description = "Runs the sync test. Usage: test_sync [n] [use_sem]"},
+     .description = "Runs the sync test. Usage: test_sync [n] [use_sem (0 none, 1 sem, 2 futex, 3 mutex)]"},
     {.name = "test_prio",
      .function = test_prio,
      .description = "Runs the priority test. Usage: test_prio [max_value] "
                     "[max_prio (optional)]"},
+    {.name = "test_mq",
+     .function = test_mq,
+     .description = "Runs the message queue test. Usage: test_mq [producers] [n]"},
+    {.name = "test_rwlock",
+     .function = test_rwlock,
+     .description = "Runs the reader-writer lock test. Usage: test_rwlock [processes] [n]"},
+    {.name = "test_shm",
+     .function = test_shm,
+     .description = "Runs the shared memory test. Usage: test_shm [writers]"},
+    {.name = "test_pi",
+     .function = test_pi,
+     .description = "Runs the mutex priority inheritance test. Usage: test_pi [work]"},
+    {.name = "test_fb",
+     .function = test_fb,
+     .description = "Runs the exclusive framebuffer test. Usage: test_fb"},
     {.name = "history",
      .function = cmd_history,
      .description = "Prints the command history"},
@@ -208,115 +226,15 @@ int main() {
     // checkea si hay un & al final y lo elimina
     uint8_t run_in_background = stripBackgroundMarker();
 
-    // Detect simple two-stage pipeline: left | right
-    char line_copy[MAX_BUFFER_SIZE];
-    strncpy(line_copy, command_history_buffer, MAX_BUFFER_SIZE - 1);
-    line_copy[MAX_BUFFER_SIZE - 1] = 0;
-    char *pipe_pos = 0;
-    {
-      int __i = 0;
-      while (line_copy[__i] != 0) {
-        if (line_copy[__i] == '|') {
-          pipe_pos = &line_copy[__i];
-          break;
-        }
-        __i++;
-      }
-    }
-
-    if (pipe_pos != NULL) {
-      // Split into left and right, trim leading/trailing spaces
-      *pipe_pos = 0;
-      char *left = line_copy;
-      char *right = pipe_pos + 1;
-      // Trim left
-      while (*left == ' ')
-        left++;
-      char *end = left + strlen(left);
-      while (end > left && *(end - 1) == ' ') {
-        *(--end) = 0;
-      }
-      // Trim right
-      while (*right == ' ')
-        right++;
-      end = right + strlen(right);
-      while (end > right && *(end - 1) == ' ') {
-        *(--end) = 0;
-      }
-
-      // Tokenize both sides
-      char *argvL[MAX_ARGS] = {0}, *argvR[MAX_ARGS] = {0};
-      int argcL = 0, argcR = 0;
-      char *tok = strtok(left, " ");
-      while (tok != NULL && argcL < MAX_ARGS - 1) {
-        argvL[argcL++] = tok;
-        tok = strtok(NULL, " ");
-      }
-      argvL[argcL] = NULL;
-      tok = strtok(right, " ");
-      while (tok != NULL && argcR < MAX_ARGS - 1) {
-        argvR[argcR++] = tok;
-        tok = strtok(NULL, " ");
-      }
-      argvR[argcR] = NULL;
-
-      if (argcL == 0 || argcR == 0) {
-        // Invalid pipeline, ignore silently
-        printf("\n");
-        buffer[0] = buffer_dim = 0;
-        continue;
-      }
-
-      // Find commands
-      int leftIdx = -1, rightIdx = -1;
-      for (int ii = 0; ii < sizeof(commands) / sizeof(Command); ii++) {
-        if (strcmp(commands[ii].name, argvL[0]) == 0)
-          leftIdx = ii;
-        if (strcmp(commands[ii].name, argvR[0]) == 0)
-          rightIdx = ii;
-      }
-      if (leftIdx == -1) {
-        fprintf(FD_STDERR, "\e[0;33mCommand not found:\e[0m %s\n", argvL[0]);
-        printf("\n");
-        buffer[0] = buffer_dim = 0;
-        continue;
-      }
-      if (rightIdx == -1) {
-        fprintf(FD_STDERR, "\e[0;33mCommand not found:\e[0m %s\n", argvR[0]);
-        printf("\n");
-        buffer[0] = buffer_dim = 0;
-        continue;
-      }
-
-      int16_t p = pipeGet();
-      if (p < 0) {
-        // If pipe cannot be created, abort silently
+    // Pipelines: cmd1 | cmd2 | ... | cmdN
+    if (strchr(command_history_buffer, '|') != NULL) {
+      char line_copy[MAX_BUFFER_SIZE];
+      strncpy(line_copy, command_history_buffer, MAX_BUFFER_SIZE - 1);
+      line_copy[MAX_BUFFER_SIZE - 1] = 0;
+      if (runPipeline(line_copy, run_in_background) == 0)
+        saveCommandToHistory(run_in_background);
+      else
         printf("\n");
-        buffer[0] = buffer_dim = 0;
-        continue;
-      }
-
-      int16_t fdsL[3] = {run_in_background ? DEV_NULL : STDIN, p, STDERR};
-      int16_t fdsR[3] = {p, run_in_background ? DEV_NULL : STDOUT, STDERR};
-
-      char **argsL = (argcL > 1) ? &argvL[1] : NULL;
-      char **argsR = (argcR > 1) ? &argvR[1] : NULL;
-
-      int32_t pidL =
-          createProcessWithFds(commands[leftIdx].function, argsL,
-                               commands[leftIdx].name, DEFAULT_PRIORITY, fdsL);
-      int32_t pidR =
-          createProcessWithFds(commands[rightIdx].function, argsR,
-                               commands[rightIdx].name, DEFAULT_PRIORITY, fdsR);
-
-      if (!run_in_background) {
-        if (pidL >= 0)
-          waitpid(pidL);
-        if (pidR >= 0)
-          waitpid(pidR);
-      }
-
-      saveCommandToHistory(run_in_background);
 
       buffer[0] = buffer_dim = 0;
       continue;
@@ -383,6 +301,96 @@ int main() {
   return 0;
 }
 
+static int findCommand(const char *name) {
+  for (int i = 0; i < sizeof(commands) / sizeof(Command); i++)
+    if (strcmp(commands[i].name, name) == 0)
+      return i;
+  return -1;
+}
+
+// Corta line en las etapas separadas por '|', crea todos los pipes, lanza
+// todas las etapas de una pasada y recién después espera a cada una
+static int runPipeline(char *line, uint8_t run_in_background) {
+  char *stages[MAX_PIPELINE_STAGES];
+  int stageCount = 0;
+  char *cursor = line;
+  while (cursor != NULL) {
+    if (stageCount == MAX_PIPELINE_STAGES) {
+      fprintf(FD_STDERR, "\e[0;33mToo many pipeline stages (max %d)\e[0m\n", MAX_PIPELINE_STAGES);
+      return -1;
+    }
+    stages[stageCount++] = cursor;
+    cursor = strchr(cursor, '|');
+    if (cursor != NULL)
+      *cursor++ = 0;
+  }
+
+  char *argvs[MAX_PIPELINE_STAGES][MAX_ARGS];
+  int commandIdx[MAX_PIPELINE_STAGES];
+  for (int s = 0; s < stageCount; s++) {
+    int argc = 0;
+    char *tok = strtok(stages[s], " ");
+    while (tok != NULL && argc < MAX_ARGS - 1) {
+      argvs[s][argc++] = tok;
+      tok = strtok(NULL, " ");
+    }
+    argvs[s][argc] = NULL;
+    if (argc == 0) // Etapa vacía: pipeline inválido
+      return -1;
+    if ((commandIdx[s] = findCommand(argvs[s][0])) == -1) {
+      fprintf(FD_STDERR, "\e[0;33mCommand not found:\e[0m %s\n", argvs[s][0]);
+      return -1;
+    }
+  }
+
+  int16_t pipes[MAX_PIPELINE_STAGES - 1][2];
+  for (int s = 0; s < stageCount - 1; s++) {
+    if (pipe(pipes[s]) < 0) {
+      perror("\e[0;31mFailed to create pipe\e[0m\n");
+      for (int t = 0; t < s; t++) {
+        close(pipes[t][0]);
+        close(pipes[t][1]);
+      }
+      return -1;
+    }
+  }
+
+  int32_t pids[MAX_PIPELINE_STAGES];
+  for (int s = 0; s < stageCount; s++) {
+    int16_t fds[3] = {
+        s == 0 ? (run_in_background ? DEV_NULL : STDIN) : pipes[s - 1][0],
+        s == stageCount - 1 ? (run_in_background ? DEV_NULL : STDOUT) : pipes[s][1],
+        STDERR};
+    Command *command = &commands[commandIdx[s]];
+    pids[s] = createProcessWithFds(command->function, argvs[s][1] != NULL ? &argvs[s][1] : NULL,
+                                   command->name, DEFAULT_PRIORITY, fds);
+  }
+
+  // Cada etapa ya tiene sus extremos: si la shell no los suelta, nadie ve EOF
+  for (int s = 0; s < stageCount - 1; s++) {
+    close(pipes[s][0]);
+    close(pipes[s][1]);
+  }
+
+  if (run_in_background) {
+    last_command_output = 0;
+    return 0;
+  }
+
+  int32_t codes[MAX_PIPELINE_STAGES];
+  for (int s = 0; s < stageCount; s++)
+    codes[s] = pids[s] >= 0 ? waitpid(pids[s]) : -1;
+
+  for (int s = 0; s < stageCount; s++) {
+    if (pids[s] < 0)
+      fprintf(FD_STDERR, "\e[0;31m[%d] %s: failed to start\e[0m\n", s + 1, argvs[s][0]);
+    else
+      printf("[%d] %s: exit %d\n", s + 1, argvs[s][0], codes[s]);
+  }
+  last_command_output = (uint64_t) codes[stageCount - 1];
+  return 0;
+}
+
 static uint8_t stripBackgroundMarker(void) {
   int idx = buffer_dim - 1;
   while (idx >= 0 && (command_history_buffer[idx] == ' ' ||
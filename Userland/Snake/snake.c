@@ -17,6 +17,7 @@
 #define BEGIN_GAME_KEY '\n'
 #define PLAY_AGAIN_KEY '\n'
 #define QUIT_KEY 'X'
+#define MAX_KEY_EVENTS 32
 
 // end_of_game values
 #define ENDED_BY_CRASH 1
@@ -66,6 +67,7 @@
 #define ANSI_1 "\e[0;96m"
 #define ANSI_2 "\e[0;31m"
 #define OFFSET 4
+#define DRAW_LIST_SIZE 256
 
 
 // <----------------------------------------------------------------------- DATA TYPES ----------------------------------------------------------------------->
@@ -118,7 +120,7 @@ static void endGame(int code);
 static void setDifficulty(char difficulty);
 static void showWinners(void);
 
-static void registerKeys(void);
+static void pollKeyEvents(uint8_t apply);
 static void movingTo(int snake, int dir_x, int dir_y);
 static void setDirection(enum REGISTERABLE_KEYS scancode);
 static void moveSnakes(void);
@@ -128,6 +130,9 @@ static int outOfBounds(int x, int y);
 static void drawBackground(void);
 static void drawSnakes(void);
 static void drawFood(void);
+static void queueRectangle(uint32_t color, int width, int height, int x, int y);
+static void queueCircle(uint32_t color, int x, int y, int diameter);
+static void submitDrawList(uint8_t flags);
 static void printScore(void);
 
 static void setRandomSeed(void);
@@ -170,6 +175,10 @@ static int difficulty_level;
 static int food_eaten;
 static int first_round;
 
+// commands of the frame being drawn, sent to the kernel in a single syscall
+static DrawCommand draw_list[DRAW_LIST_SIZE];
+static uint32_t draw_list_size;
+
 
 // ================================================================================ GAME ================================================================================
 
@@ -182,7 +191,7 @@ int main(void) {
     welcomePlayers();
 
     setRandomSeed();
-    registerKeys();
+    openKeyEvents();
     setSquareDimensions();
 
     do{
@@ -193,15 +202,18 @@ int main(void) {
         first_round = 1;
         drawBackground();
         printScore();
+        pollKeyEvents(0); // keys pressed between rounds do not count
 
         while(!end_of_game) {
             drawSnakes();
             drawFood();
+            submitDrawList(DRAW_FLUSH);
         
             sleep(difficulty_level);
 
             stopBeep();
 
+            pollKeyEvents(1);
             moveSnakes();
             checkFoodEaten();
             checkCrash();
@@ -291,8 +303,10 @@ static void welcomePlayers(void) {
     sleep(DEFAULT_INSTRUCTIONS_SLEEPING_TIME);
 
     printf("If any player eats %d foods, becomes the winner.\n\nDon't crash against the walls!\n\nAt any time, press X to quit.\n\nPress ENTER to begin", MAX_BODY_SIZE - INITIAL_BODY_SIZE - 1);
+    fflush(stdout);
 
-    while(getCharacterWithoutDisplay() != BEGIN_GAME_KEY);
+    setConsoleMode(CONSOLE_RAW); // from here on keys are read one by one, without echo
+    while(getchar() != BEGIN_GAME_KEY);
 
     clearScreen();
 }
@@ -367,8 +381,9 @@ static void showWinners(void) {
 
         printf("\n\e[0;32m----------------------------------------------------------------\e[0m \
         \n\n\t\t\tPress ENTER to play again, X to finish");
+        fflush(stdout);
 
-        while((c = getCharacterWithoutDisplay()) != PLAY_AGAIN_KEY && toupper(c) != QUIT_KEY);
+        while((c = getchar()) != PLAY_AGAIN_KEY && toupper(c) != QUIT_KEY);
 
         if(c == PLAY_AGAIN_KEY){
             end_of_game = 0;
@@ -379,20 +394,23 @@ static void showWinners(void) {
 
 // ================================================================================ MOVING LOGIC ================================================================================
 
-static void registerKeys(void) {
-    // player 1 keys
-    registerKey(KP_UP_KEY, setDirection);
-    registerKey(KP_DOWN_KEY, setDirection);
-    registerKey(KP_LEFT_KEY, setDirection);
-    registerKey(KP_RIGHT_KEY, setDirection);
-
-    // player 2 keys
-    registerKey(W_KEY, setDirection);
-    registerKey(S_KEY, setDirection);
-    registerKey(A_KEY, setDirection);
-    registerKey(D_KEY, setDirection);
+// Drains every key pressed since the last frame, in order; with apply == 0 they are discarded
+static void pollKeyEvents(uint8_t apply) {
+    KeyEvent events[MAX_KEY_EVENTS];
+    int64_t count;
 
-    registerKey(X_KEY, (void (*)(enum REGISTERABLE_KEYS scancode)) endGameByQuit);
+    while((count = readKeyEvents(events, MAX_KEY_EVENTS)) > 0){
+        for(int64_t i = 0; apply && i < count; i++){
+            if(!events[i].pressed){
+                continue;
+            }
+            if(events[i].scancode == X_KEY){
+                endGameByQuit();
+            } else{
+                setDirection(events[i].scancode);
+            }
+        }
+    }
 }
 
 static void movingTo(int snake, int dir_x, int dir_y) {
@@ -502,25 +520,45 @@ static void drawBackground(void) {
     for(int y = border_y; y < window_height; y += square.height){
         for(int x = 0; x < window_width; x += square.width){
             if(first_round || !(x == food.position.x && y == food.position.y)){
-                drawRectangle(DEFAULT_BACKGROUND_COLOR, square.width - OFFSET, square.height - OFFSET, x + OFFSET, y + OFFSET);
+                queueRectangle(DEFAULT_BACKGROUND_COLOR, square.width - OFFSET, square.height - OFFSET, x + OFFSET, y + OFFSET);
             }
         }
     }
+    submitDrawList(0);
 }
 
 static void drawSnakes(void) {
     for(int i = 0; i < snakes_amount; i++){
         //set last (phantom) snake body's rectangle to black
-        drawRectangle(DEFAULT_BACKGROUND_COLOR, square.width - OFFSET, square.height - OFFSET, snakes[i].body[snakes[i].size - 1].position.x + OFFSET, snakes[i].body[snakes[i].size - 1].position.y + OFFSET);
+        queueRectangle(DEFAULT_BACKGROUND_COLOR, square.width - OFFSET, square.height - OFFSET, snakes[i].body[snakes[i].size - 1].position.x + OFFSET, snakes[i].body[snakes[i].size - 1].position.y + OFFSET);
 
         for(int k = 0; k < snakes[i].size - 1; k++){
-            drawRectangle(hsv2rgb(k * 10 + snakes[i].initial_hue, 255, 255), square.width - OFFSET, square.height - OFFSET, snakes[i].body[k].position.x + OFFSET, snakes[i].body[k].position.y + OFFSET);
+            queueRectangle(hsv2rgb(k * 10 + snakes[i].initial_hue, 255, 255), square.width - OFFSET, square.height - OFFSET, snakes[i].body[k].position.x + OFFSET, snakes[i].body[k].position.y + OFFSET);
         }
     }
 }
 
 static void drawFood(void) {
-    drawCircle(food.hue, food.position.x + OFFSET, food.position.y + OFFSET, SQUARE_DIM - OFFSET);
+    queueCircle(food.hue, food.position.x + OFFSET, food.position.y + OFFSET, SQUARE_DIM - OFFSET);
+}
+
+static void queueRectangle(uint32_t color, int width, int height, int x, int y) {
+    if(draw_list_size == DRAW_LIST_SIZE){
+        submitDrawList(0);
+    }
+    draw_list[draw_list_size++] = (DrawCommand) { .type = DRAW_RECTANGLE, .color = color, .x = x, .y = y, .width = width, .height = height };
+}
+
+static void queueCircle(uint32_t color, int x, int y, int diameter) {
+    if(draw_list_size == DRAW_LIST_SIZE){
+        submitDrawList(0);
+    }
+    draw_list[draw_list_size++] = (DrawCommand) { .type = DRAW_CIRCLE, .color = color, .x = x, .y = y, .width = diameter };
+}
+
+static void submitDrawList(uint8_t flags) {
+    drawBatch(draw_list, draw_list_size, flags);
+    draw_list_size = 0;
 }
 
 static void printScore(void) {
@@ -535,6 +573,7 @@ static void printScore(void) {
             printf("%sPlayer %d score: %d\e[0m", snakes[i].main_ansi, i + 1, snakes[i].size - (INITIAL_BODY_SIZE + 1));
         }
     }
+    fflush(stdout);
 }
 
 
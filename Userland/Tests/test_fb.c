@@ -0,0 +1,73 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <stdint.h>
+#include <stdio.h>
+#include <libsys/sys.h>
+
+#define FB_COLOR 0x00204060
+#define FLUSH_WAIT_MS 500
+
+int16_t static backgroundFds[3] = {DEV_NULL, FD_STDOUT, FD_STDERR};
+
+static inline uint8_t *pixelAt(const FramebufferInfo *info, uint16_t x, uint16_t y) {
+  return info->address + (uint64_t) y * info->pitch + (uint64_t) x * (info->bpp / 8);
+}
+
+static void fillScreen(const FramebufferInfo *info, uint32_t color) {
+  for (uint16_t y = 0; y < info->height; y++)
+    for (uint16_t x = 0; x < info->width; x++) {
+      uint8_t *pixel = pixelAt(info, x, y);
+      pixel[0] = color & 0xFF;
+      pixel[1] = (color >> 8) & 0xFF;
+      pixel[2] = (color >> 16) & 0xFF;
+    }
+}
+
+static uint64_t countOverwritten(const FramebufferInfo *info, uint32_t color) {
+  uint64_t overwritten = 0;
+  for (uint16_t y = 0; y < info->height; y++)
+    for (uint16_t x = 0; x < info->width; x++) {
+      uint8_t *pixel = pixelAt(info, x, y);
+      if (pixel[0] != (color & 0xFF) || pixel[1] != ((color >> 8) & 0xFF) || pixel[2] != ((color >> 16) & 0xFF))
+        overwritten++;
+    }
+  return overwritten;
+}
+
+// Sin la consola como entrada no es del trabajo en primer plano: no puede tomar la pantalla
+static int fb_background(int argc, char **argv) {
+  FramebufferInfo info;
+  if (acquireFramebuffer(&info) == -1)
+    return 0;
+  releaseFramebuffer();
+  return 1;
+}
+
+// Mientras el test es dueño del framebuffer, ni la salida de consola ni el flush
+// periódico del back buffer pueden pisar lo que dibujó
+int test_fb(int argc, char **argv) {
+  FramebufferInfo info;
+  if (acquireFramebuffer(&info) == -1) {
+    printf("test_fb: ERROR acquiring framebuffer\n");
+    return -1;
+  }
+
+  fillScreen(&info, FB_COLOR);
+  printf("test_fb: this line must not appear until the framebuffer is released\n");
+  sleep(FLUSH_WAIT_MS);
+  uint64_t overwritten = countOverwritten(&info, FB_COLOR);
+
+  int32_t released = releaseFramebuffer();
+  int32_t releasedTwice = releaseFramebuffer();
+
+  char *argvChild[] = {NULL};
+  int64_t background = createProcessWithFds(fb_background, argvChild, "fb_background", 4, backgroundFds);
+  int32_t backgroundAcquired = background < 0 ? -1 : waitpid(background);
+  if (backgroundAcquired != 0)
+    printf("test_fb: ERROR a background process %s\n", background < 0 ? "could not be created" : "acquired the framebuffer");
+
+  uint8_t ok = overwritten == 0 && released == 0 && releasedTwice == -1 && backgroundAcquired == 0;
+  printf("test_fb: %s (%d pixels overwritten while owned)\n", ok ? "OK" : "ERROR", (int) overwritten);
+  return ok ? 0 : -1;
+}
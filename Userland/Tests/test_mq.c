@@ -0,0 +1,111 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <stdint.h>
+#include <stdio.h>
+#include <libsys/sys.h>
+#include "tests/test_util.h"
+
+#define MQ_NAME "test_mq"
+#define QUEUE_CAPACITY 4
+#define MAX_PRODUCERS 32
+
+int16_t static fileDescriptors[3] = {0, 1, 2};
+
+typedef struct {
+  uint64_t value;
+} TestMessage;
+
+int mq_producer(int argc, char **argv) {
+  uint64_t n;
+  if (argc != 1 || (n = satoi(argv[0])) <= 0)
+    return -1;
+
+  int16_t queue = mqOpen(MQ_NAME);
+  if (queue == -1) {
+    printf("test_mq: ERROR opening queue\n");
+    return -1;
+  }
+
+  for (uint64_t i = 1; i <= n; i++) {
+    TestMessage message = {.value = i};
+    if (mqSend(queue, &message, sizeof(message), i % MQ_PRIORITIES, 0) != sizeof(message)) {
+      printf("test_mq: ERROR sending message\n");
+      mqClose(queue);
+      return -1;
+    }
+  }
+
+  mqClose(queue);
+  return 0;
+}
+
+static int checkPriorityOrder(int16_t queue) {
+  uint8_t sent[] = {1, 5, 3};
+  uint8_t expected[] = {5, 3, 1};
+  TestMessage message;
+  uint8_t priority;
+
+  for (int i = 0; i < 3; i++) {
+    message.value = sent[i];
+    if (mqSend(queue, &message, sizeof(message), sent[i], MQ_NONBLOCK) == -1)
+      return -1;
+  }
+  for (int i = 0; i < 3; i++) {
+    if (mqReceive(queue, &message, sizeof(message), &priority, MQ_NONBLOCK) == -1 ||
+        priority != expected[i] || message.value != expected[i])
+      return -1;
+  }
+  // Vacía: un receive no bloqueante tiene que fallar
+  return mqReceive(queue, &message, sizeof(message), &priority, MQ_NONBLOCK) == -1 ? 0 : -1;
+}
+
+int test_mq(int argc, char **argv) { //{producers, messages}
+  if (argc != 2) {
+    printf("test_mq: ERROR invalid arguments\n");
+    return -1;
+  }
+
+  int64_t producers = satoi(argv[0]);
+  int64_t n = satoi(argv[1]);
+  if (producers <= 0 || n <= 0)
+    return -1;
+  if (producers > MAX_PRODUCERS)
+    producers = MAX_PRODUCERS;
+
+  int16_t queue = mqCreate(MQ_NAME, QUEUE_CAPACITY, sizeof(TestMessage));
+  if (queue == -1) {
+    printf("test_mq: ERROR creating queue\n");
+    return -1;
+  }
+
+  if (checkPriorityOrder(queue) == -1) {
+    printf("test_mq: ERROR priority order\n");
+    mqClose(queue);
+    return -1;
+  }
+
+  char *argvProducer[] = {argv[1], NULL};
+  int64_t pids[MAX_PRODUCERS];
+  for (int64_t i = 0; i < producers; i++)
+    pids[i] = createProcessWithFds(mq_producer, argvProducer, "mq_producer", 4, fileDescriptors);
+
+  // La cola es chica a propósito: los productores se bloquean hasta que consumimos
+  uint64_t total = 0;
+  TestMessage message;
+  for (int64_t i = 0; i < producers * n; i++) {
+    if (mqReceive(queue, &message, sizeof(message), NULL, 0) != sizeof(message)) {
+      printf("test_mq: ERROR receiving message\n");
+      break;
+    }
+    total += message.value;
+  }
+
+  for (int64_t i = 0; i < producers; i++)
+    waitpid(pids[i]);
+  mqClose(queue);
+
+  uint64_t expected = producers * (n * (n + 1) / 2);
+  printf("test_mq: %s (received sum %d, expected %d)\n", total == expected ? "OK" : "ERROR", (int) total, (int) expected);
+  return total == expected ? 0 : -1;
+}
@@ -0,0 +1,85 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <stdint.h>
+#include <stdio.h>
+#include <libsys/sys.h>
+#include "tests/test_util.h"
+
+#define LOW_PRIORITY 0
+#define MEDIUM_PRIORITY 2
+#define HIGH_PRIORITY 4
+#define LOW_ROUNDS 4
+#define MEDIUM_ROUNDS 64
+#define WAIT_MS 10
+
+int16_t static fileDescriptors[3] = {0, 1, 2};
+
+// La imagen de la shell es compartida: los procesos del test se coordinan por globales
+static int16_t pi_mutex;
+static uint64_t pi_work;
+static volatile uint8_t low_holds;
+static volatile uint8_t finished;
+static volatile uint8_t high_done_at, medium_done_at;
+
+// Toma el mutex y trabaja con él; a mitad de camino duerme, así despierta heredando
+int pi_low(int argc, char **argv) {
+  mutexLock(pi_mutex);
+  low_holds = 1;
+  for (int i = 0; i < LOW_ROUNDS; i++) {
+    bussy_wait(pi_work);
+    if (i == LOW_ROUNDS / 2)
+      sleep(WAIT_MS);
+  }
+  mutexUnlock(pi_mutex);
+  return 0;
+}
+
+// Ocupa la CPU y se vuelve a poner en MEDIUM_PRIORITY para no decaer: sin herencia,
+// el proceso de prioridad baja no corre hasta que este termine
+int pi_medium(int argc, char **argv) {
+  for (int i = 0; i < MEDIUM_ROUNDS; i++) {
+    nice(getpid(), MEDIUM_PRIORITY);
+    bussy_wait(pi_work);
+  }
+  medium_done_at = ++finished;
+  return 0;
+}
+
+int pi_high(int argc, char **argv) {
+  mutexLock(pi_mutex);
+  high_done_at = ++finished;
+  mutexUnlock(pi_mutex);
+  return 0;
+}
+
+int test_pi(int argc, char **argv) { //{work}
+  if (argc != 1 || (pi_work = satoi(argv[0])) <= 0) {
+    printf("test_pi: ERROR invalid arguments\n");
+    return -1;
+  }
+
+  if ((pi_mutex = mutexCreate()) == -1) {
+    printf("test_pi: ERROR creating mutex\n");
+    return -1;
+  }
+  low_holds = 0;
+  finished = high_done_at = medium_done_at = 0;
+
+  char *argvChild[] = {NULL};
+  int64_t low = createProcessWithFds(pi_low, argvChild, "pi_low", LOW_PRIORITY, fileDescriptors);
+  while (!low_holds)
+    sleep(WAIT_MS);
+  int64_t medium = createProcessWithFds(pi_medium, argvChild, "pi_medium", MEDIUM_PRIORITY, fileDescriptors);
+  int64_t high = createProcessWithFds(pi_high, argvChild, "pi_high", HIGH_PRIORITY, fileDescriptors);
+
+  waitpid(low);
+  waitpid(medium);
+  waitpid(high);
+  mutexDestroy(pi_mutex);
+
+  // Con herencia, el de prioridad baja termina la sección crítica antes que el de media
+  uint8_t ok = high_done_at != 0 && high_done_at < medium_done_at;
+  printf("test_pi: %s (high finished %s medium)\n", ok ? "OK" : "ERROR", ok ? "before" : "after");
+  return ok ? 0 : -1;
+}
@@ -0,0 +1,86 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <stdint.h>
+#include <stdio.h>
+#include <libsys/sys.h>
+#include "tests/test_util.h"
+
+#define MAX_RW_PROCESSES 32
+
+int16_t static fileDescriptors[3] = {0, 1, 2};
+
+// Los escritores actualizan las dos mitades con un yield en el medio:
+// un lector que las vea distintas entró mientras escribían
+static volatile int64_t first;
+static volatile int64_t second;
+static volatile int64_t torn_reads;
+static int16_t rwlock = -1;
+
+int rw_writer(int argc, char **argv) {
+  uint64_t n;
+  if (argc != 1 || (n = satoi(argv[0])) <= 0)
+    return -1;
+
+  for (uint64_t i = 0; i < n; i++) {
+    rwlockWriteLock(rwlock);
+    first = first + 1;
+    yield();
+    second = second + 1;
+    rwlockWriteUnlock(rwlock);
+  }
+  return 0;
+}
+
+int rw_reader(int argc, char **argv) {
+  uint64_t n;
+  if (argc != 1 || (n = satoi(argv[0])) <= 0)
+    return -1;
+
+  for (uint64_t i = 0; i < n; i++) {
+    rwlockReadLock(rwlock);
+    int64_t a = first;
+    yield(); // Otros lectores pueden entrar acá, los escritores no
+    if (a != second)
+      torn_reads++;
+    rwlockReadUnlock(rwlock);
+  }
+  return 0;
+}
+
+int test_rwlock(int argc, char **argv) { //{processes, n}
+  if (argc != 2) {
+    printf("test_rwlock: ERROR invalid arguments\n");
+    return -1;
+  }
+
+  int64_t processes = satoi(argv[0]);
+  int64_t n = satoi(argv[1]);
+  if (processes <= 0 || n <= 0)
+    return -1;
+  if (processes > MAX_RW_PROCESSES)
+    processes = MAX_RW_PROCESSES;
+
+  if ((rwlock = rwlockCreate()) == -1) {
+    printf("test_rwlock: ERROR creating lock\n");
+    return -1;
+  }
+  first = second = torn_reads = 0;
+
+  char *argvChild[] = {argv[1], NULL};
+  int64_t pids[2 * MAX_RW_PROCESSES];
+  for (int64_t i = 0; i < processes; i++) {
+    pids[i] = createProcessWithFds(rw_writer, argvChild, "rw_writer", 4, fileDescriptors);
+    pids[i + processes] = createProcessWithFds(rw_reader, argvChild, "rw_reader", 4, fileDescriptors);
+  }
+  for (int64_t i = 0; i < 2 * processes; i++)
+    waitpid(pids[i]);
+
+  rwlockDestroy(rwlock);
+  rwlock = -1;
+
+  int ok = torn_reads == 0 && first == processes * n && second == first;
+  printf("test_rwlock: %s (writes %d, expected %d, torn reads %d)\n", ok ? "OK" : "ERROR",
+         (int) second, (int) (processes * n), (int) torn_reads);
+  return ok ? 0 : -1;
+}
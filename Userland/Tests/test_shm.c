@@ -0,0 +1,88 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <stdint.h>
+#include <stdio.h>
+#include <libsys/sys.h>
+#include "tests/test_util.h"
+
+#define SHM_KEY 0x5348
+#define SHM_SIZE 4096
+#define MAX_WRITERS 32
+#define PARENT_MARK 0xCAFE
+
+int16_t static fileDescriptors[3] = {0, 1, 2};
+
+// Cada escritor ve la marca del padre y deja la suya en su propio slot
+int shm_writer(int argc, char **argv) {
+  int64_t index;
+  if (argc != 1 || (index = satoi(argv[0])) < 0 || index >= MAX_WRITERS)
+    return -1;
+
+  uint64_t *segment = (uint64_t *) shmAttach(SHM_KEY);
+  if (segment == NULL)
+    return -1;
+  if (segment[0] == PARENT_MARK)
+    segment[index + 1] = index + 1;
+  return shmDetach(segment) == 0 ? 0 : -1;
+}
+
+// Después de destroy la key ya no se puede adjuntar, y al soltar la última referencia
+// el segmento se libera, así que la misma key se puede volver a crear
+static int checkDestroy(uint64_t *segment) {
+  if (shmDestroy(SHM_KEY) == -1 || shmAttach(SHM_KEY) != NULL)
+    return -1;
+  if (shmDetach(segment) == -1 || shmDetach(segment) != -1)
+    return -1;
+  if (shmCreate(SHM_KEY, SHM_SIZE) == -1)
+    return -1;
+  return shmDestroy(SHM_KEY);
+}
+
+int test_shm(int argc, char **argv) { //{writers}
+  if (argc != 1) {
+    printf("test_shm: ERROR invalid arguments\n");
+    return -1;
+  }
+
+  int64_t writers = satoi(argv[0]);
+  if (writers <= 0)
+    return -1;
+  if (writers > MAX_WRITERS)
+    writers = MAX_WRITERS;
+
+  if (shmCreate(SHM_KEY, SHM_SIZE) == -1) {
+    printf("test_shm: ERROR creating segment\n");
+    return -1;
+  }
+  uint64_t *segment = (uint64_t *) shmAttach(SHM_KEY);
+  if (segment == NULL) {
+    printf("test_shm: ERROR attaching segment\n");
+    shmDestroy(SHM_KEY);
+    return -1;
+  }
+  segment[0] = PARENT_MARK;
+
+  char indexes[MAX_WRITERS][4];
+  int64_t pids[MAX_WRITERS];
+  for (int64_t i = 0; i < writers; i++) {
+    snprintf(indexes[i], sizeof(indexes[i]), "%d", (int) i);
+    char *argvWriter[] = {indexes[i], NULL};
+    pids[i] = createProcessWithFds(shm_writer, argvWriter, "shm_writer", 4, fileDescriptors);
+  }
+  for (int64_t i = 0; i < writers; i++)
+    waitpid(pids[i]);
+
+  int64_t seen = 0;
+  for (int64_t i = 0; i < writers; i++)
+    if (segment[i + 1] == (uint64_t) (i + 1))
+      seen++;
+
+  if (checkDestroy(segment) == -1) {
+    printf("test_shm: ERROR detach/destroy\n");
+    return -1;
+  }
+
+  printf("test_shm: %s (%d of %d writers seen)\n", seen == writers ? "OK" : "ERROR", (int) seen, (int) writers);
+  return seen == writers ? 0 : -1;
+}
@@ -6,11 +6,16 @@
 #include <libsys/sys.h>
 #include "tests/test_util.h"
 
-#define SEM_ID 67
+#define SEM_NAME "test_sync"
 
 #define MAX_PAIR_PROCESSES 170
 
+#define USE_FUTEX 2
+#define USE_MUTEX 3
+
 int64_t global; // shared memory
+FutexMutex futexMutex;
+int16_t kernelMutex = -1;
 
 int16_t static fileDescriptors[3] = {0, 1, 2};
 
@@ -25,6 +30,7 @@ int my_process_inc(int argc, char **argv) {
   uint64_t n;
   int8_t inc;
   int8_t use_sem;
+  int32_t sem = -1;
 
   if (argc != 3)
     return -1;
@@ -36,21 +42,32 @@ int my_process_inc(int argc, char **argv) {
   if ((use_sem = satoi(argv[2])) < 0)
     return -1;
 
-  if (use_sem)
-    if (semOpen(SEM_ID, 1) == -1) {
+  if (use_sem == 1)
+    if ((sem = semOpenNamed(SEM_NAME, 1)) == -1) {
       printf("test_sync: ERROR opening semaphore\n");
       return -1;
     }
 
   uint64_t i;
   for (i = 0; i < n; i++) {
-    if (use_sem)
-      semWait(SEM_ID);
+    if (use_sem == USE_FUTEX)
+      futexMutexLock(&futexMutex);
+    else if (use_sem == USE_MUTEX)
+      mutexLock(kernelMutex);
+    else if (use_sem)
+      semWait(sem);
     slowInc(&global, inc);
-    if (use_sem)
-      semPost(SEM_ID);
+    if (use_sem == USE_FUTEX)
+      futexMutexUnlock(&futexMutex);
+    else if (use_sem == USE_MUTEX)
+      mutexUnlock(kernelMutex);
+    else if (use_sem)
+      semPost(sem);
   }
 
+  if (use_sem == 1)
+    semClose(sem);
+
 
   return 0;
 }
@@ -67,6 +84,11 @@ uint64_t test_sync(uint64_t argc, char *argv[]) { //{n, use_sem, 0}
   char *argvInc[] = {argv[0], "1", argv[1], NULL};
 
   global = 0;
+  futexMutexInit(&futexMutex);
+  if (satoi(argv[1]) == USE_MUTEX && (kernelMutex = mutexCreate()) == -1) {
+    printf("test_sync: ERROR creating mutex\n");
+    return -1;
+  }
 
   uint64_t i;
   for (i = 0; i < TOTAL_PAIR_PROCESSES; i++) {
@@ -79,8 +101,10 @@ uint64_t test_sync(uint64_t argc, char *argv[]) { //{n, use_sem, 0}
     waitpid(pids[i + TOTAL_PAIR_PROCESSES]);
   }
 
-  if (satoi(argv[1]) == 1)
-    semClose(SEM_ID);
+  if (kernelMutex != -1) {
+    mutexDestroy(kernelMutex);
+    kernelMutex = -1;
+  }
 
   printf("Final value: %d\n", (int)global);
 
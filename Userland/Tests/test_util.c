@@ -72,6 +72,7 @@ void endless_loop_print(uint64_t wait) {
 
   while (1) {
     printf("%lld ", (long long)pid);
+    fflush(stdout);
     bussy_wait(wait);
   }
 }
@@ -3,16 +3,46 @@
 
 #include <string.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
 
 #define FD_STDIN  0
 #define FD_STDOUT 1
 #define FD_STDERR 2
 #define DEV_NULL (-1)
 
+#define BUFSIZ 512
+#define EOF (-1)
+
+// stdout and stderr are buffered per process: line by line while they are attached to
+// the console, by whole buffers when redirected (pipes, /dev/null). Output pending at
+// return from the process' main function is flushed; a process killed loses it.
+// stdin reads ahead whatever the kernel hands over (a whole line from the console).
+typedef struct FILE {
+    int16_t fd;
+    uint8_t mode;
+    uint16_t length;
+    uint16_t position; // next character to read, input streams only
+    char buffer[BUFSIZ];
+} FILE;
+
+FILE * stdioStream(int fd);
+#define stdin stdioStream(FD_STDIN)
+#define stdout stdioStream(FD_STDOUT)
+#define stderr stdioStream(FD_STDERR)
+
+// Writes out the pending output of stream, or of every output stream if it is NULL
+int fflush(FILE * stream);
+
 void puts(const char * str);
 void vprintf(const char * str, va_list args);
 void printf(const char * str, ...);
 void fprintf(int fd, const char * str, ...);
+void vfprintf(int fd, const char * format, va_list args);
+// Format into buffer without any syscall. At most size - 1 characters are stored and
+// the result is always terminated; returns the length the full output would have had.
+int vsnprintf(char * buffer, size_t size, const char * format, va_list args);
+int snprintf(char * buffer, size_t size, const char * format, ...);
 int vscanf(const char * format, va_list args);
 int vsscanf(const char * buffer, const char * format, va_list args);
 int sscanf(const char * str, const char * format, ...);
@@ -11,6 +11,7 @@ void strcpy(char * dest, const char * src);
 void strncpy(char * dest, const char * src, int n);
 void perror(const char * s1);
 char * strtok(char * s1, const char * s2);
+char * strchr(const char * str, int c);
 void * memset(void * destination, int32_t character, uint64_t length);
 
 #endif
\ No newline at end of file
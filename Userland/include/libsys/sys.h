@@ -108,8 +108,70 @@ void clearScreen(void);
 void drawCircle(uint32_t color, long long int topleftX, long long int topLefyY, long long int diameter);
 void drawRectangle(uint32_t color, long long int width_pixels, long long int height_pixels, long long int initial_pos_x, long long int initial_pos_y);
 void fillVideoMemory(uint32_t hexColor);
+// Drawing goes to a back buffer that the kernel copies to the screen on every
+// timer tick; videoFlush shows what was drawn right away (e.g. a whole frame)
+void videoFlush(void);
+
+// Draw lists: many primitives in a single syscall (same layout as the kernel's DrawCommand)
+#define MAX_DRAW_COMMANDS 4096
+#define DRAW_FLUSH 0x01 // flush the back buffer once the whole list is drawn
+
+typedef enum {
+    DRAW_RECTANGLE = 0,
+    DRAW_CIRCLE,
+    DRAW_FILL,
+    DRAW_BITMAP,
+    DRAW_CIRCLE_OUTLINE,
+    DRAW_ROUNDED_RECTANGLE
+} DrawCommandType;
+
+typedef struct DrawCommand {
+    uint8_t type;
+    uint32_t color;
+    uint16_t x, y;           // top left corner
+    uint16_t width, height;  // DRAW_CIRCLE uses width as the diameter
+    const uint32_t * pixels; // DRAW_BITMAP: width * height pixels, 0x00RRGGBB
+    uint16_t radius;         // DRAW_ROUNDED_RECTANGLE: corner radius
+    uint16_t thickness;      // DRAW_CIRCLE_OUTLINE: border width
+} DrawCommand;
+
+// Returns the amount of commands drawn, or -1 if the list is invalid (nothing is drawn)
+int64_t drawBatch(const DrawCommand * commands, uint32_t count, uint8_t flags);
+
+// Image blits: one syscall copies a whole image (any stride, 24 or 32 bpp source) to
+// the screen, clipped to its borders. Same layout as the kernel's Blit.
+#define BLIT_COLOR_KEY 0x01 // pixels equal to colorKey are transparent
+
+typedef struct Blit {
+    const void * pixels; // B G R (24bpp) or B G R X (32bpp) per pixel
+    uint32_t stride;     // bytes between source rows
+    uint16_t width;      // source size in pixels
+    uint16_t height;
+    uint8_t bpp;         // 24 or 32
+    uint8_t flags;
+    uint8_t scale;       // integer scale factor (>= 1)
+    uint32_t colorKey;   // 0x00RRGGBB, transparent if flags & BLIT_COLOR_KEY
+    int32_t x, y;        // destination, may be partially off screen
+} Blit;
+
+int32_t blitImage(const Blit * blit);
+
+// Direct access to the visible framebuffer (same layout as the kernel's FramebufferInfo).
+// Only the foreground process can acquire it; it is handed back on exit. While it is
+// owned nothing else is drawn on screen: console output shows up once it is released.
+typedef struct FramebufferInfo {
+    uint8_t * address;
+    uint16_t pitch;     // bytes per row
+    uint16_t width;
+    uint16_t height;
+    uint8_t bpp;        // bits per pixel (24 or 32), stored as B, G, R
+} FramebufferInfo;
+
+int32_t acquireFramebuffer(FramebufferInfo * info);
+int32_t releaseFramebuffer(void);
 int32_t exec(int32_t (*fnPtr)(void));
 int32_t execProgram(int32_t (*fnPtr)(void));
+// fn runs in this process, with its descriptors, while it waits for console input
 void registerKey(enum REGISTERABLE_KEYS scancode, void (*fn)(enum REGISTERABLE_KEYS scancode));
 void clearInputBuffer(void);
 int getWindowWidth(void);
@@ -118,6 +180,33 @@ void sleep(uint32_t milliseconds);
 int32_t getRegisterSnapshot(int64_t * registers);
 int32_t getCharacterWithoutDisplay(void);
 
+// Console input modes. Canonical: the kernel echoes and edits the line, and a read
+// returns it whole once RETURN (or ^D) is pressed. Raw: no echo, keys are returned as
+// they are typed. Raw mode is undone when the process that set it exits.
+#define CONSOLE_CANONICAL 0
+#define CONSOLE_RAW 1
+int32_t setConsoleMode(uint8_t mode);
+
+// Key events: once subscribed, every key press and release is queued for this process
+// with its timestamp, so a game loop can drain all of them once per frame. The ring
+// keeps the last 128 events; the subscription ends when the process exits.
+#define KEY_MOD_SHIFT     0x01
+#define KEY_MOD_CONTROL   0x02
+#define KEY_MOD_CAPS_LOCK 0x04
+
+typedef struct KeyEvent {
+    uint64_t ticks;     // timer ticks since boot
+    uint8_t scancode;   // enum REGISTERABLE_KEYS
+    uint8_t pressed;    // 1 key down, 0 key up
+    uint8_t modifiers;  // KEY_MOD_* held when the event happened
+    int8_t ascii;       // translated character, 0 if the key has none
+} KeyEvent;
+
+int32_t openKeyEvents(void);
+// Never blocks: returns how many events were copied (0 if none), -1 if not subscribed
+int64_t readKeyEvents(KeyEvent * events, uint32_t max);
+int32_t closeKeyEvents(void);
+
 // Process and synchronization API
 int32_t getpid(void);
 int32_t waitpid(int32_t pid);
@@ -134,6 +223,33 @@ int32_t semWait(uint16_t sem_id);
 int32_t semPost(uint16_t sem_id);
 int32_t semClose(uint16_t sem_id);
 int32_t semDestroy(uint16_t sem_id);
+// Opens or creates a named semaphore and returns its id (use it with semWait/semPost).
+// semClose drops this process' reference; the semaphore is destroyed with the last one
+// and references are dropped automatically when the process exits.
+int32_t semOpenNamed(const char *name, uint32_t initialValue);
+
+// Futex-based primitives: the counter lives in user memory and the kernel is
+// only entered to sleep or wake on contention. Objects must be shared memory
+// (a global of the image or a shm segment) to be used across processes.
+typedef struct {
+    volatile int32_t state;
+} FutexMutex;
+
+typedef struct {
+    volatile int32_t count;
+    volatile int32_t waiters;
+} FutexSemaphore;
+
+int32_t futexWait(volatile int32_t *address, int32_t expected);
+int32_t futexWake(volatile int32_t *address, uint32_t count);
+void futexMutexInit(FutexMutex *mutex);
+void futexMutexLock(FutexMutex *mutex);
+int32_t futexMutexTryLock(FutexMutex *mutex);
+void futexMutexUnlock(FutexMutex *mutex);
+void futexSemInit(FutexSemaphore *sem, int32_t initialValue);
+void futexSemWait(FutexSemaphore *sem);
+int32_t futexSemTryWait(FutexSemaphore *sem);
+void futexSemPost(FutexSemaphore *sem);
 
 // Memory API
 void *malloc(uint64_t size);
@@ -148,7 +264,70 @@ typedef struct {
 int32_t getMemoryState(MMState *state);
 int32_t printProcesses(void);
 
-// Pipes
-int16_t pipeGet(void);
+// File descriptors. Each process has its own table; createProcessWithFds
+// builds the child's 0..2 from the given descriptors of the caller
+// (DEV_NULL discards). Other descriptors are not inherited.
+// pipe() fills fds[0] with the read end and fds[1] with the write end
+int32_t pipe(int16_t fds[2]);
+int16_t dup(int16_t fd);
+int16_t dup2(int16_t fd, int16_t newFd);
+int32_t close(int16_t fd);
+// The hook runs before dup2 replaces or close drops fd, while it still names the old file.
+// exec and setConsoleMode run it for stdin (fd 0), whose input changes meaning
+void setRedirectHook(void (*hook)(int16_t fd));
+
+// Kernel mutexes with an owner and priority inheritance: while someone waits,
+// the owner runs at least at the waiter's priority. Only the owner can unlock
+int16_t mutexCreate(void);
+int32_t mutexLock(uint16_t id);
+int32_t mutexUnlock(uint16_t id);
+int32_t mutexDestroy(uint16_t id);
+
+// Condition variables tied to a kernel mutex: condWait releases the mutex
+// while sleeping and holds it again when it returns
+int16_t condCreate(void);
+int32_t condWait(uint16_t id, uint16_t mutexId);
+int32_t condSignal(uint16_t id);
+int32_t condBroadcast(uint16_t id);
+int32_t condDestroy(uint16_t id);
+
+// Reader-writer locks with writer preference
+int16_t rwlockCreate(void);
+int32_t rwlockReadLock(uint16_t id);
+int32_t rwlockReadUnlock(uint16_t id);
+int32_t rwlockWriteLock(uint16_t id);
+int32_t rwlockWriteUnlock(uint16_t id);
+int32_t rwlockDestroy(uint16_t id);
+
+// Shared memory: page-aligned segments identified by key
+int32_t shmCreate(uint32_t key, uint64_t size);
+void *shmAttach(uint32_t key);
+int32_t shmDetach(void *address);
+int32_t shmDestroy(uint32_t key);
+
+// Message queues
+#define MQ_PRIORITIES 8
+#define MQ_MAX_MESSAGES 256
+#define MQ_MAX_MESSAGE_SIZE 1024
+#define MQ_NONBLOCK 0x01
+
+int16_t mqCreate(const char *name, uint16_t maxMessages, uint16_t messageSize);
+int16_t mqOpen(const char *name);
+int32_t mqClose(uint16_t id);
+int64_t mqSend(uint16_t id, const void *message, uint16_t length, uint8_t priority, uint8_t flags);
+int64_t mqReceive(uint16_t id, void *buffer, uint16_t length, uint8_t *priority, uint8_t flags);
+
+// Process local storage: a zeroed block private to each process, allocated on first use.
+// Program statics are shared by every process running the same image, so per-process
+// state (the stdio buffers) lives here. The kernel keeps the running process' pointer
+// at PROCESS_LOCAL_STORAGE_ADDRESS, so reading it costs no syscall.
+#define PROCESS_LOCAL_STORAGE_ADDRESS 0x96000
+#define PROCESS_LOCAL_STORAGE_SIZE 2048
+
+void *processLocalStorage(void);
+// The hook runs when the process returns from its main function, not when it is killed
+int32_t setExitHook(void (*hook)(void));
+// 1 if fd refers to the console, 0 otherwise
+int32_t isatty(int16_t fd);
 
 #endif
\ No newline at end of file
@@ -42,6 +42,16 @@ int32_t sys_rectangle(int color, long long int width_pixels, long long int heigh
 
 int32_t sys_fill_video_memory(uint32_t hexColor);
 
+int32_t sys_video_flush(void);
+
+int32_t sys_draw_batch(const DrawCommand * commands, uint64_t count, uint8_t flags);
+
+int32_t sys_framebuffer_acquire(FramebufferInfo * info);
+
+int32_t sys_framebuffer_release(void);
+
+int32_t sys_blit(const Blit * blit);
+
 int32_t sys_exec(int32_t (*fnPtr)(void));
 
 int32_t sys_register_key(uint8_t scancode, void (*fn)(enum REGISTERABLE_KEYS scancode));
@@ -56,6 +66,16 @@ int32_t sys_get_register_snapshot(int64_t * registers);
 
 int32_t sys_get_character_without_display(void);
 
+/* 0x800000F1 */
+int32_t sys_set_console_mode(uint8_t mode);
+
+/* 0x800000F2 */
+int32_t sys_key_events_open(void);
+/* 0x800000F3 */
+int64_t sys_key_events_read(KeyEvent * events, uint32_t max);
+/* 0x800000F4 */
+int32_t sys_key_events_close(void);
+
 // Extra process/memory helpers
 int32_t sys_mm_state(void *state);
 int32_t sys_print_ps(void);
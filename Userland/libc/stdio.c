@@ -6,76 +6,123 @@
 #include <libc/string.h>
 #include <syscalls.h>
 
-#ifdef ANSI_4_BIT_COLOR_SUPPORT
-    #include <ansiColors.h>
-#endif
+#define STREAMS 3           // stdin, stdout and stderr, indexed by fd
+#define MODE_UNKNOWN 0      // decided on first use: the fd may be redirected
+#define MODE_LINE 1
+#define MODE_FULL 2
+#define MODE_INPUT 3
 
-static char buffer[64] = {0};
+typedef struct StdioState {
+    uint8_t initialized;
+    FILE streams[STREAMS];
+} StdioState;
+
+// The hook lives in this image's libsys: a program run through exec finds the process'
+// streams initialized by the caller and still has to install its own
+static uint8_t redirectHookSet = 0;
+
+// Where formatted characters go: a stream, or a caller's buffer for snprintf
+typedef struct Output {
+    FILE * stream;
+    char * memory;
+    size_t size;
+    size_t count;
+    uint8_t pendingLine;
+} Output;
 
 static uint32_t uintToBase(uint64_t value, char * buffer, uint32_t base);
-static void printBase(int fd, int num, int base);
-static void writeString(int fd, const char *str);
+static void formatOutput(Output * out, const char * format, va_list args);
+static void emitChar(Output * out, char c);
+static void emitString(Output * out, const char * str);
+static void printBase(Output * out, int num, int base);
+static void writeStream(int fd, const char * format, va_list args);
+static void flushStream(FILE * stream);
+static void flushStreams(uint8_t mode);
+static void flushAtExit(void);
+static void streamRedirected(int16_t fd);
 // static void printFloat(int fd, float num);
 
+FILE * stdioStream(int fd) {
+    if (fd < FD_STDIN || fd >= STREAMS) {
+        return NULL;
+    }
+    StdioState * state = (StdioState *) processLocalStorage();
+    if (state == NULL) {
+        return NULL;
+    }
+    if (!state->initialized) {
+        for (int i = 0; i < STREAMS; i++) {
+            state->streams[i].fd = i;
+            state->streams[i].mode = i == FD_STDIN ? MODE_INPUT : MODE_UNKNOWN;
+            state->streams[i].length = 0;
+            state->streams[i].position = 0;
+        }
+        state->initialized = 1;
+        setExitHook(flushAtExit);
+    }
+    if (!redirectHookSet) {
+        setRedirectHook(streamRedirected);
+        redirectHookSet = 1;
+    }
+    FILE * stream = &state->streams[fd];
+    if (stream->mode == MODE_UNKNOWN) {
+        stream->mode = isatty(fd) ? MODE_LINE : MODE_FULL;
+    }
+    return stream;
+}
+
+int fflush(FILE * stream) {
+    if (stream != NULL) {
+        flushStream(stream);
+        return 0;
+    }
+    flushStreams(MODE_UNKNOWN);
+    return 0;
+}
+
 void puts(const char * str) {
-    writeString(FD_STDOUT, str);
-    sys_write(FD_STDOUT, "\n", 1);
+    fprintf(FD_STDOUT, "%s\n", str);
 }
 
 void vfprintf(int fd, const char * format, va_list args) {
-    int i = 0;
-    while (format[i] != 0) {
-        switch (format[i]) {
-        case '\e':
-        #ifdef ANSI_4_BIT_COLOR_SUPPORT
-            sys_write(fd, &format[i], 0); // "writes" (ignored because of count=0) \e char to account for fd changes
-            parseANSI(format, &i);
-            break ;
-        #else
-            while(format[i] != 'm') i++; // ignore ANSI escape codes, assumes valid \e[X,Ym format
-            i++;
-            break ;
-        #endif
-        case '%':
-            i++;
-            switch (format[i]) {
-                case 'x': printBase(fd, va_arg(args, int), 16); break ;
-                case 'd': printBase(fd, va_arg(args, int), 10); break ;
-                case 'o': printBase(fd, va_arg(args, int), 8); break ;
-                case 'b': printBase(fd, va_arg(args, int), 2); break ;
-                // case 'f': printFloat(fd, va_arg(args, double)); break ;
-                case 'c': {
-                    char c = (char) va_arg(args, int);
-                    sys_write(fd, &c, 1);
-                    break ;
-                }
-                case 's': writeString(fd, va_arg(args, char *)); break ;
-                case '%': sys_write(fd, "%", 1); break ;
-            }
-            i++;
-            break ;
-        default:
-            sys_write(fd, &format[i], 1);
-            i++;
-            break ;
-        }
-    }
+    writeStream(fd, format, args);
+}
+
+void vprintf(const char * format, va_list args) {
+    writeStream(FD_STDOUT, format, args);
 }
 
 void printf(const char * format, ...) {
     va_list args;
     va_start(args, format);
-    vfprintf(FD_STDOUT, format, args);
+    writeStream(FD_STDOUT, format, args);
     va_end(args);
 }
 
 void fprintf(int fd, const char * str, ...) {
     va_list args;
     va_start(args, str);
-    vfprintf(fd, str, args);
+    writeStream(fd, str, args);
     va_end(args);
 }
 
+int vsnprintf(char * buffer, size_t size, const char * fmt, va_list args) {
+    Output out = {.stream = NULL, .memory = buffer, .size = size, .count = 0, .pendingLine = 0};
+    formatOutput(&out, fmt, args);
+    if (size > 0) {
+        buffer[out.count < size ? out.count : size - 1] = 0;
+    }
+    return (int) out.count;
+}
+
+int snprintf(char * buffer, size_t size, const char * fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int count = vsnprintf(buffer, size, fmt, args);
+    va_end(args);
+    return count;
+}
+
 int vscanf(const char * format, va_list args) {
     int i = 0;
     int args_read = 0;
@@ -92,7 +139,7 @@ int vscanf(const char * format, va_list args) {
                         c = getchar();
 
                         if (c != '-' && (c < '0' || c > '9')) {
-                            while ((c = getchar()) != '\n'); // empty input buffer
+                            while ((c = getchar()) != '\n' && c != EOF); // empty input buffer
                             break ;
                         };
 
@@ -112,7 +159,7 @@ int vscanf(const char * format, va_list args) {
                         break;
                     case 's':
                         char * str = va_arg(args, char *);
-                        while ((c = getchar()) != ' ' && c != '\n') {
+                        while ((c = getchar()) != ' ' && c != '\n' && c != EOF) {
                             *str = c;
                             str++;
                         }
@@ -195,17 +242,35 @@ int scanf(const char * format, ...) {
 }
 
 void perror(const char * s1) {
-    writeString(FD_STDERR, s1);
+    fprintf(FD_STDERR, "%s", s1);
 }
 
+// The console hands over a whole line per read (a pipe, whatever it holds), so getchar
+// only goes to the kernel once the previous read has been consumed
 int getchar(void) {
-    signed char c[1];
-    while(sys_read(FD_STDIN, c, 1) == -1);
-    return c[0];
+    FILE * in = stdin;
+    if (in == NULL) {
+        signed char c[1];
+        flushStreams(MODE_LINE);
+        int32_t count;
+        while((count = sys_read(FD_STDIN, c, 1)) == -1);
+        return count == 0 ? EOF : c[0];
+    }
+    if (in->position == in->length) {
+        flushStreams(MODE_LINE); // a prompt without a trailing newline has to be visible before blocking
+        int32_t count;
+        while((count = sys_read(FD_STDIN, in->buffer, BUFSIZ)) == -1);
+        if (count == 0) {
+            return EOF;
+        }
+        in->length = count;
+        in->position = 0;
+    }
+    return (signed char) in->buffer[in->position++];
 }
 
 void putchar(const char c) {
-    sys_write(FD_STDOUT, &c, 1);
+    fprintf(FD_STDOUT, "%c", c);
 };
 
 static uint32_t uintToBase(uint64_t value, char * buffer, uint32_t base)
@@ -241,19 +306,131 @@ static uint32_t uintToBase(uint64_t value, char * buffer, uint32_t base)
 	return digits;
 }
 
-static void printBase(int fd, int num, int base) {
+// A stream that is not stdout/stderr (or when there is no local storage) is buffered on
+// the stack for the length of the call, so every printf is at most one write per BUFSIZ
+static void writeStream(int fd, const char * fmt, va_list args) {
+    FILE local = {.fd = fd, .mode = MODE_FULL, .length = 0};
+    FILE * stream = fd == FD_STDIN ? NULL : stdioStream(fd);
+    if (stream == NULL) {
+        stream = &local;
+    } else if (fd == FD_STDERR) {
+        fflush(stdout); // keep the order both streams were written in
+    }
+
+    Output out = {.stream = stream, .memory = NULL, .size = 0, .count = 0, .pendingLine = 0};
+    formatOutput(&out, fmt, args);
+    if (stream == &local || out.pendingLine) {
+        flushStream(stream);
+    }
+}
+
+static void formatOutput(Output * out, const char * format, va_list args) {
+    int i = 0;
+    while (format[i] != 0) {
+        switch (format[i]) {
+        case '%':
+            i++;
+            switch (format[i]) {
+                case 'x': printBase(out, va_arg(args, int), 16); break ;
+                case 'd': printBase(out, va_arg(args, int), 10); break ;
+                case 'o': printBase(out, va_arg(args, int), 8); break ;
+                case 'b': printBase(out, va_arg(args, int), 2); break ;
+                // case 'f': printFloat(fd, va_arg(args, double)); break ;
+                case 'c': emitChar(out, (char) va_arg(args, int)); break ;
+                case 's': emitString(out, va_arg(args, char *)); break ;
+                case '%': emitChar(out, '%'); break ;
+            }
+            i++;
+            break ;
+        default: // ANSI escape sequences are written as-is: the kernel console interprets them
+            emitChar(out, format[i]);
+            i++;
+            break ;
+        }
+    }
+}
+
+static void emitChar(Output * out, char c) {
+    FILE * stream = out->stream;
+    if (stream == NULL) {
+        if (out->count + 1 < out->size) {
+            out->memory[out->count] = c;
+        }
+        out->count++;
+        return;
+    }
+    if (stream->length == BUFSIZ) {
+        flushStream(stream);
+        out->pendingLine = 0;
+    }
+    stream->buffer[stream->length++] = c;
+    out->count++;
+    if (c == '\n' && stream->mode == MODE_LINE) {
+        out->pendingLine = 1; // one write per call, not one per line
+    }
+}
+
+static void emitString(Output * out, const char * str) {
+    if (str == NULL) {
+        str = "(null)";
+    }
+    while (*str != 0) {
+        emitChar(out, *str++);
+    }
+}
+
+static void printBase(Output * out, int num, int base) {
+    char digits[66];
     int64_t value = num;
     if (value < 0) {
-        sys_write(fd, "-", 1);
+        emitChar(out, '-');
         value = -value;
     }
-    uintToBase((uint64_t)value, buffer, base);
-    writeString(fd, buffer);
+    uintToBase((uint64_t)value, digits, base);
+    emitString(out, digits);
 }
 
-static void writeString(int fd, const char *str) {
-    if (str == NULL) {
-        str = "(null)";
+static void flushStream(FILE * stream) {
+    if (stream->mode == MODE_INPUT) { // flushing stdin drops what was read ahead
+        stream->length = stream->position = 0;
+        return;
+    }
+    if (stream->length > 0) {
+        sys_write(stream->fd, stream->buffer, stream->length);
+        stream->length = 0;
+    }
+}
+
+// MODE_UNKNOWN flushes every stream, otherwise only those in the given mode
+static void flushStreams(uint8_t mode) {
+    StdioState * state = (StdioState *) processLocalStorage();
+    if (state == NULL || !state->initialized) {
+        return;
+    }
+    for (int i = FD_STDOUT; i < STREAMS; i++) {
+        if (mode == MODE_UNKNOWN || state->streams[i].mode == mode) {
+            flushStream(&state->streams[i]);
+        }
+    }
+}
+
+static void flushAtExit(void) {
+    flushStreams(MODE_UNKNOWN);
+}
+
+// Pending output belongs to the file fd named until now, and the buffering mode is
+// decided again for the new one. stdin drops what it read ahead from the old source
+static void streamRedirected(int16_t fd) {
+    if (fd < FD_STDIN || fd >= STREAMS) {
+        return;
+    }
+    StdioState * state = (StdioState *) processLocalStorage();
+    if (state == NULL || !state->initialized) {
+        return;
+    }
+    FILE * stream = &state->streams[fd];
+    flushStream(stream);
+    if (fd != FD_STDIN) {
+        stream->mode = MODE_UNKNOWN;
     }
-    sys_write(fd, str, strlen(str));
 }
@@ -55,6 +55,18 @@ void strncpy(char * dest, const char * src, int n) {
     }
 }
 
+// The terminator is part of the string: strchr(str, 0) points at it
+char * strchr(const char * str, int c) {
+    for (;; str++) {
+        if (*str == (char) c) {
+            return (char *) str;
+        }
+        if (*str == 0) {
+            return NULL;
+        }
+    }
+}
+
 char * strtok(char * s1, const char * s2) {
     static char * last;
 
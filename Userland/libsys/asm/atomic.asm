@@ -0,0 +1,37 @@
+GLOBAL _atomic_xadd32
+GLOBAL _atomic_xchg32
+GLOBAL _atomic_cmpxchg32
+
+section .text
+
+; int32_t _atomic_xadd32(volatile int32_t *addr, int32_t delta)
+; Suma delta a *addr y devuelve el valor anterior
+_atomic_xadd32:
+    push rbp
+    mov rbp, rsp
+    mov eax, esi
+    lock xadd [rdi], eax
+    mov rsp, rbp
+    pop rbp
+    ret
+
+; int32_t _atomic_xchg32(volatile int32_t *addr, int32_t newValue)
+_atomic_xchg32:
+    push rbp
+    mov rbp, rsp
+    mov eax, esi
+    xchg [rdi], eax         ; xchg con memoria es implícitamente lock
+    mov rsp, rbp
+    pop rbp
+    ret
+
+; int32_t _atomic_cmpxchg32(volatile int32_t *addr, int32_t expected, int32_t newValue)
+; Devuelve el valor que había en *addr (== expected si el intercambio se hizo)
+_atomic_cmpxchg32:
+    push rbp
+    mov rbp, rsp
+    mov eax, esi
+    lock cmpxchg [rdi], edx
+    mov rsp, rbp
+    pop rbp
+    ret
@@ -17,6 +17,11 @@ GLOBAL sys_sleep_milis
 GLOBAL sys_circle
 GLOBAL sys_rectangle
 GLOBAL sys_fill_video_memory
+GLOBAL sys_video_flush
+GLOBAL sys_draw_batch
+GLOBAL sys_framebuffer_acquire
+GLOBAL sys_framebuffer_release
+GLOBAL sys_blit
 
 GLOBAL sys_exec
 
@@ -28,6 +33,10 @@ GLOBAL sys_window_height
 GLOBAL sys_get_register_snapshot
 
 GLOBAL sys_get_character_without_display
+GLOBAL sys_set_console_mode
+GLOBAL sys_key_events_open
+GLOBAL sys_key_events_read
+GLOBAL sys_key_events_close
 GLOBAL sys_getpid
 GLOBAL sys_create_process
 GLOBAL sys_nice_proc
@@ -40,6 +49,9 @@ GLOBAL sys_sem_wait
 GLOBAL sys_sem_post
 GLOBAL sys_sem_close
 GLOBAL sys_sem_destroy
+GLOBAL sys_futex_wait
+GLOBAL sys_futex_wake
+GLOBAL sys_sem_open_named
 GLOBAL sys_yield_proc
 GLOBAL sys_wait_proc
 GLOBAL sys_mm_state
@@ -47,7 +59,43 @@ GLOBAL sys_print_ps
 GLOBAL sys_malloc
 GLOBAL sys_free
 
-GLOBAL sys_pipe_get
+GLOBAL sys_pipe
+GLOBAL sys_dup
+GLOBAL sys_dup2
+GLOBAL sys_close
+
+GLOBAL sys_mq_create
+GLOBAL sys_mq_open
+GLOBAL sys_mq_close
+GLOBAL sys_mq_send
+GLOBAL sys_mq_receive
+
+GLOBAL sys_shm_create
+GLOBAL sys_shm_attach
+GLOBAL sys_shm_detach
+GLOBAL sys_shm_destroy
+
+GLOBAL sys_mutex_create
+GLOBAL sys_mutex_lock
+GLOBAL sys_mutex_unlock
+GLOBAL sys_mutex_destroy
+
+GLOBAL sys_cond_create
+GLOBAL sys_cond_wait
+GLOBAL sys_cond_signal
+GLOBAL sys_cond_broadcast
+GLOBAL sys_cond_destroy
+
+GLOBAL sys_rwlock_create
+GLOBAL sys_rwlock_read_lock
+GLOBAL sys_rwlock_read_unlock
+GLOBAL sys_rwlock_write_lock
+GLOBAL sys_rwlock_write_unlock
+GLOBAL sys_rwlock_destroy
+
+GLOBAL sys_local_storage
+GLOBAL sys_set_exit_hook
+GLOBAL sys_isatty
 
 ; ============================
 section .text
@@ -84,6 +132,11 @@ sys_second: sys_int80 0x80000012
 sys_circle: sys_int80 0x80000019
 sys_rectangle: sys_int80 0x80000020
 sys_fill_video_memory: sys_int80 0x80000021
+sys_video_flush: sys_int80 0x80000022
+sys_draw_batch: sys_int80 0x80000023
+sys_framebuffer_acquire: sys_int80 0x80000024
+sys_framebuffer_release: sys_int80 0x80000025
+sys_blit: sys_int80 0x80000026
 
 sys_exec: sys_int80 0x800000A0
 
@@ -97,6 +150,10 @@ sys_sleep_milis: sys_int80 0x800000D0
 sys_get_register_snapshot: sys_int80 0x800000E0
 
 sys_get_character_without_display: sys_int80 0x800000F0
+sys_set_console_mode: sys_int80 0x800000F1
+sys_key_events_open: sys_int80 0x800000F2
+sys_key_events_read: sys_int80 0x800000F3
+sys_key_events_close: sys_int80 0x800000F4
 
 ; ============================
 ; Process and sync syscalls
@@ -115,6 +172,9 @@ sys_sem_wait:          sys_int80 0x80000112
 sys_sem_post:          sys_int80 0x80000113
 sys_sem_close:         sys_int80 0x80000114
 sys_sem_destroy:       sys_int80 0x80000115
+sys_futex_wait:        sys_int80 0x80000116
+sys_futex_wake:        sys_int80 0x80000117
+sys_sem_open_named:    sys_int80 0x80000118
 
 sys_yield_proc:        sys_int80 0x80000120
 sys_wait_proc:         sys_int80 0x80000121
@@ -122,4 +182,40 @@ sys_mm_state:          sys_int80 0x80000130
 sys_print_ps:          sys_int80 0x80000131
 sys_malloc:            sys_int80 0x80000132
 sys_free:              sys_int80 0x80000133
-sys_pipe_get:          sys_int80 0x80000140
\ No newline at end of file
+sys_pipe:              sys_int80 0x80000140
+sys_dup:               sys_int80 0x80000141
+sys_dup2:              sys_int80 0x80000142
+sys_close:             sys_int80 0x80000143
+
+sys_mq_create:         sys_int80 0x80000150
+sys_mq_open:           sys_int80 0x80000151
+sys_mq_close:          sys_int80 0x80000152
+sys_mq_send:           sys_int80 0x80000153
+sys_mq_receive:        sys_int80 0x80000154
+
+sys_shm_create:        sys_int80 0x80000160
+sys_shm_attach:        sys_int80 0x80000161
+sys_shm_detach:        sys_int80 0x80000162
+sys_shm_destroy:       sys_int80 0x80000163
+
+sys_mutex_create:      sys_int80 0x80000170
+sys_mutex_lock:        sys_int80 0x80000171
+sys_mutex_unlock:      sys_int80 0x80000172
+sys_mutex_destroy:     sys_int80 0x80000173
+
+sys_cond_create:       sys_int80 0x80000180
+sys_cond_wait:         sys_int80 0x80000181
+sys_cond_signal:       sys_int80 0x80000182
+sys_cond_broadcast:    sys_int80 0x80000183
+sys_cond_destroy:      sys_int80 0x80000184
+
+sys_rwlock_create:       sys_int80 0x80000190
+sys_rwlock_read_lock:    sys_int80 0x80000191
+sys_rwlock_read_unlock:  sys_int80 0x80000192
+sys_rwlock_write_lock:   sys_int80 0x80000193
+sys_rwlock_write_unlock: sys_int80 0x80000194
+sys_rwlock_destroy:      sys_int80 0x80000195
+
+sys_local_storage:       sys_int80 0x800001A0
+sys_set_exit_hook:       sys_int80 0x800001A1
+sys_isatty:              sys_int80 0x800001A2
@@ -0,0 +1,85 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <sys.h>
+
+extern int32_t sys_futex_wait(volatile int32_t *address, int32_t expected);
+extern int32_t sys_futex_wake(volatile int32_t *address, uint32_t count);
+
+extern int32_t _atomic_xadd32(volatile int32_t *address, int32_t delta);
+extern int32_t _atomic_xchg32(volatile int32_t *address, int32_t newValue);
+extern int32_t _atomic_cmpxchg32(volatile int32_t *address, int32_t expected, int32_t newValue);
+
+// Estados del mutex (ver Drepper, "Futexes Are Tricky")
+#define UNLOCKED 0
+#define LOCKED 1
+#define LOCKED_WITH_WAITERS 2
+
+int32_t futexWait(volatile int32_t *address, int32_t expected) {
+    return sys_futex_wait(address, expected);
+}
+
+int32_t futexWake(volatile int32_t *address, uint32_t count) {
+    return sys_futex_wake(address, count);
+}
+
+void futexMutexInit(FutexMutex *mutex) {
+    mutex->state = UNLOCKED;
+}
+
+void futexMutexLock(FutexMutex *mutex) {
+    int32_t state = _atomic_cmpxchg32(&mutex->state, UNLOCKED, LOCKED);
+    if (state == UNLOCKED) {
+        return; // Sin contención: ninguna syscall
+    }
+    if (state != LOCKED_WITH_WAITERS) {
+        state = _atomic_xchg32(&mutex->state, LOCKED_WITH_WAITERS);
+    }
+    while (state != UNLOCKED) {
+        sys_futex_wait(&mutex->state, LOCKED_WITH_WAITERS);
+        state = _atomic_xchg32(&mutex->state, LOCKED_WITH_WAITERS);
+    }
+}
+
+int32_t futexMutexTryLock(FutexMutex *mutex) {
+    return _atomic_cmpxchg32(&mutex->state, UNLOCKED, LOCKED) == UNLOCKED ? 0 : -1;
+}
+
+void futexMutexUnlock(FutexMutex *mutex) {
+    // Solo se entra al kernel si alguien marcó que está esperando
+    if (_atomic_xadd32(&mutex->state, -1) != LOCKED) {
+        mutex->state = UNLOCKED;
+        sys_futex_wake(&mutex->state, 1);
+    }
+}
+
+void futexSemInit(FutexSemaphore *sem, int32_t initialValue) {
+    sem->count = initialValue;
+    sem->waiters = 0;
+}
+
+int32_t futexSemTryWait(FutexSemaphore *sem) {
+    int32_t count;
+    while ((count = sem->count) > 0) {
+        if (_atomic_cmpxchg32(&sem->count, count, count - 1) == count) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void futexSemWait(FutexSemaphore *sem) {
+    while (futexSemTryWait(sem) != 0) {
+        // El kernel vuelve en el acto si count dejó de ser 0 antes de dormir
+        _atomic_xadd32(&sem->waiters, 1);
+        sys_futex_wait(&sem->count, 0);
+        _atomic_xadd32(&sem->waiters, -1);
+    }
+}
+
+void futexSemPost(FutexSemaphore *sem) {
+    _atomic_xadd32(&sem->count, 1);
+    if (sem->waiters > 0) {
+        sys_futex_wake(&sem->count, 1);
+    }
+}
@@ -4,6 +4,15 @@
 #include <sys.h>
 #include <syscalls.h>
 
+#define STDIN_FD 0
+
+// Shared by every process of the image; stdio installs the same function in all of them
+static void (*redirectHook)(int16_t fd) = 0;
+
+void setRedirectHook(void (*hook)(int16_t fd)) {
+    redirectHook = hook;
+}
+
 void startBeep(uint32_t nFrequence) {
     sys_start_beep(nFrequence);
 }
@@ -27,6 +36,7 @@ extern int32_t sys_sem_wait(uint16_t sem_id);
 extern int32_t sys_sem_post(uint16_t sem_id);
 extern int32_t sys_sem_close(uint16_t sem_id);
 extern int32_t sys_sem_destroy(uint16_t sem_id);
+extern int32_t sys_sem_open_named(const char *name, uint64_t initialValue);
 extern int32_t sys_yield_proc(void);
 extern int32_t sys_wait_proc(int64_t pid);
 extern int32_t sys_mm_state(void *state);
@@ -88,6 +98,10 @@ int32_t semDestroy(uint16_t sem_id) {
     return sys_sem_destroy(sem_id);
 }
 
+int32_t semOpenNamed(const char *name, uint32_t initialValue) {
+    return sys_sem_open_named(name, initialValue);
+}
+
 void setTextColor(uint32_t color) {
     sys_fonts_text_color(color);
 }
@@ -134,8 +148,37 @@ void fillVideoMemory(uint32_t hexColor) {
     sys_fill_video_memory(hexColor);
 }
 
+void videoFlush(void) {
+    sys_video_flush();
+}
+
+int64_t drawBatch(const DrawCommand * commands, uint32_t count, uint8_t flags) {
+    return sys_draw_batch(commands, count, flags);
+}
+
+int32_t blitImage(const Blit * blit) {
+    return sys_blit(blit);
+}
+
+int32_t acquireFramebuffer(FramebufferInfo * info) {
+    return sys_framebuffer_acquire(info);
+}
+
+int32_t releaseFramebuffer(void) {
+    return sys_framebuffer_release();
+}
+
+// The program runs in this process and shares its stdio state: neither side may
+// read what the other one read ahead from stdin
 int32_t exec(int32_t (*fnPtr)(void)) {
-    return sys_exec(fnPtr);
+    if (redirectHook != 0) {
+        redirectHook(STDIN_FD);
+    }
+    int32_t result = sys_exec(fnPtr);
+    if (redirectHook != 0) {
+        redirectHook(STDIN_FD);
+    }
+    return result;
 }
 
 void registerKey(enum REGISTERABLE_KEYS scancode, void (*fn)(enum REGISTERABLE_KEYS scancode)) {
@@ -163,6 +206,25 @@ int32_t getCharacterWithoutDisplay(void) {
     return sys_get_character_without_display();
 }
 
+int32_t setConsoleMode(uint8_t mode) {
+    if (redirectHook != 0) { // input read ahead in the old mode is not meant for the new one
+        redirectHook(STDIN_FD);
+    }
+    return sys_set_console_mode(mode);
+}
+
+int32_t openKeyEvents(void) {
+    return sys_key_events_open();
+}
+
+int64_t readKeyEvents(KeyEvent * events, uint32_t max) {
+    return sys_key_events_read(events, max);
+}
+
+int32_t closeKeyEvents(void) {
+    return sys_key_events_close();
+}
+
 int32_t getMemoryState(MMState *state) {
     return sys_mm_state((void *)state);
 }
@@ -171,10 +233,175 @@ int32_t printProcesses(void) {
     return sys_print_ps();
 }
 
-extern int32_t sys_pipe_get(void);
-int16_t pipeGet(void) {
-    return (int16_t) sys_pipe_get();
+extern int32_t sys_pipe(int16_t fds[2]);
+extern int32_t sys_dup(int16_t fd);
+extern int32_t sys_dup2(int16_t fd, int16_t newFd);
+extern int32_t sys_close(int16_t fd);
+
+int32_t pipe(int16_t fds[2]) {
+    return sys_pipe(fds);
+}
+
+int16_t dup(int16_t fd) {
+    return (int16_t) sys_dup(fd);
+}
+
+int16_t dup2(int16_t fd, int16_t newFd) {
+    if (redirectHook != 0) {
+        redirectHook(newFd);
+    }
+    return (int16_t) sys_dup2(fd, newFd);
+}
+
+int32_t close(int16_t fd) {
+    if (redirectHook != 0) {
+        redirectHook(fd);
+    }
+    return sys_close(fd);
+}
+
+extern int32_t sys_mq_create(const char *name, uint16_t maxMessages, uint16_t messageSize);
+extern int32_t sys_mq_open(const char *name);
+extern int32_t sys_mq_close(uint16_t id);
+extern int64_t sys_mq_send(uint16_t id, const void *message, uint16_t length, uint8_t priority, uint8_t flags);
+extern int64_t sys_mq_receive(uint16_t id, void *buffer, uint16_t length, uint8_t *priority, uint8_t flags);
+
+int16_t mqCreate(const char *name, uint16_t maxMessages, uint16_t messageSize) {
+    return (int16_t) sys_mq_create(name, maxMessages, messageSize);
+}
+
+int16_t mqOpen(const char *name) {
+    return (int16_t) sys_mq_open(name);
+}
+
+int32_t mqClose(uint16_t id) {
+    return sys_mq_close(id);
+}
+
+int64_t mqSend(uint16_t id, const void *message, uint16_t length, uint8_t priority, uint8_t flags) {
+    return sys_mq_send(id, message, length, priority, flags);
+}
+
+int64_t mqReceive(uint16_t id, void *buffer, uint16_t length, uint8_t *priority, uint8_t flags) {
+    return sys_mq_receive(id, buffer, length, priority, flags);
+}
+
+extern int32_t sys_shm_create(uint32_t key, uint64_t size);
+extern void *sys_shm_attach(uint32_t key);
+extern int32_t sys_shm_detach(void *address);
+extern int32_t sys_shm_destroy(uint32_t key);
+
+int32_t shmCreate(uint32_t key, uint64_t size) {
+    return sys_shm_create(key, size);
+}
+
+void *shmAttach(uint32_t key) {
+    return sys_shm_attach(key);
+}
+
+int32_t shmDetach(void *address) {
+    return sys_shm_detach(address);
+}
+
+int32_t shmDestroy(uint32_t key) {
+    return sys_shm_destroy(key);
+}
+
+extern int32_t sys_mutex_create(void);
+extern int32_t sys_mutex_lock(uint16_t id);
+extern int32_t sys_mutex_unlock(uint16_t id);
+extern int32_t sys_mutex_destroy(uint16_t id);
+
+int16_t mutexCreate(void) {
+    return (int16_t) sys_mutex_create();
+}
+
+int32_t mutexLock(uint16_t id) {
+    return sys_mutex_lock(id);
+}
+
+int32_t mutexUnlock(uint16_t id) {
+    return sys_mutex_unlock(id);
+}
+
+int32_t mutexDestroy(uint16_t id) {
+    return sys_mutex_destroy(id);
+}
+
+extern int32_t sys_cond_create(void);
+extern int32_t sys_cond_wait(uint16_t id, uint16_t mutexId);
+extern int32_t sys_cond_signal(uint16_t id);
+extern int32_t sys_cond_broadcast(uint16_t id);
+extern int32_t sys_cond_destroy(uint16_t id);
+
+int16_t condCreate(void) {
+    return (int16_t) sys_cond_create();
+}
+
+int32_t condWait(uint16_t id, uint16_t mutexId) {
+    return sys_cond_wait(id, mutexId);
+}
+
+int32_t condSignal(uint16_t id) {
+    return sys_cond_signal(id);
+}
+
+int32_t condBroadcast(uint16_t id) {
+    return sys_cond_broadcast(id);
 }
+
+int32_t condDestroy(uint16_t id) {
+    return sys_cond_destroy(id);
+}
+
+extern int32_t sys_rwlock_create(void);
+extern int32_t sys_rwlock_read_lock(uint16_t id);
+extern int32_t sys_rwlock_read_unlock(uint16_t id);
+extern int32_t sys_rwlock_write_lock(uint16_t id);
+extern int32_t sys_rwlock_write_unlock(uint16_t id);
+extern int32_t sys_rwlock_destroy(uint16_t id);
+
+int16_t rwlockCreate(void) {
+    return (int16_t) sys_rwlock_create();
+}
+
+int32_t rwlockReadLock(uint16_t id) {
+    return sys_rwlock_read_lock(id);
+}
+
+int32_t rwlockReadUnlock(uint16_t id) {
+    return sys_rwlock_read_unlock(id);
+}
+
+int32_t rwlockWriteLock(uint16_t id) {
+    return sys_rwlock_write_lock(id);
+}
+
+int32_t rwlockWriteUnlock(uint16_t id) {
+    return sys_rwlock_write_unlock(id);
+}
+
+int32_t rwlockDestroy(uint16_t id) {
+    return sys_rwlock_destroy(id);
+}
+
+extern void *sys_local_storage(void);
+extern int32_t sys_set_exit_hook(void (*hook)(void));
+extern int32_t sys_isatty(int16_t fd);
+
+void *processLocalStorage(void) {
+    void *storage = *((void * volatile *) PROCESS_LOCAL_STORAGE_ADDRESS);
+    return storage != 0 ? storage : sys_local_storage();
+}
+
+int32_t setExitHook(void (*hook)(void)) {
+    return sys_set_exit_hook(hook);
+}
+
+int32_t isatty(int16_t fd) {
+    return sys_isatty(fd);
+}
+
 void *malloc(uint64_t size) {
     return sys_malloc(size);
 }